@@ -0,0 +1,119 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "b64.h"
+
+// The number of the simulated requests
+#define NUM_REQUESTS 20000
+
+// The number of encoding/decoding in a request
+#define NUM_OPS_PER_REQUEST 64
+
+// Maximum byte size of the input of an encoding
+#define MAX_INPUT_SIZE 256
+
+// Byte size of the arena for a request
+#define ARENA_SIZE (NUM_OPS_PER_REQUEST * 2 * (MAX_INPUT_SIZE * 2 + 16))
+
+// The number of iterations of each measurement
+#define NUM_ITERATIONS 5
+
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint8_t input_bytes[MAX_INPUT_SIZE];
+static size_t input_sizes[NUM_OPS_PER_REQUEST];
+
+// Run the requests, each request encodes/decodes small inputs and releases all at the end
+static double run_requests(B64Arena* arena) {
+    B64Allocator allocator = (arena == NULL) ? b64_default_allocator : b64_arena_allocator(arena);
+
+    void* ptrs[NUM_OPS_PER_REQUEST * 2];
+    size_t checksum = 0;
+
+    double start = get_time();
+    for (int r = 0; r < NUM_REQUESTS; ++r) {
+        for (int i = 0; i < NUM_OPS_PER_REQUEST; ++i) {
+            size_t length;
+            char* encoded_str = b64_encode_with_allocator(&length, input_bytes, input_sizes[i], &b64_std_alphabet, true, 0, &allocator);
+            size_t size;
+            uint8_t* decoded_bytes = b64_decode_with_allocator_n(&size, encoded_str, length, &b64_std_alphabet, true, &allocator);
+            if ((encoded_str == NULL) || (decoded_bytes == NULL)) {
+                fprintf(stderr, "Error: encoding/decoding failed\n");
+                exit(EXIT_FAILURE);
+            }
+            checksum += decoded_bytes[size - 1];
+            ptrs[i * 2] = encoded_str;
+            ptrs[i * 2 + 1] = decoded_bytes;
+        }
+
+        // End of the request
+        if (arena == NULL) {
+            for (int i = 0; i < (NUM_OPS_PER_REQUEST * 2); ++i) {
+                free(ptrs[i]);
+            }
+        } else {
+            b64_arena_reset(arena);
+        }
+    }
+    double elapsed = get_time() - start;
+
+    if (checksum == 0) {
+        fprintf(stderr, "Error: decoding result is wrong\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return elapsed;
+}
+
+// Measure the time per encoding/decoding in nanoseconds
+static double measure(B64Arena* arena) {
+    double best = 0.0;
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        double elapsed = run_requests(arena);
+        if ((best == 0.0) || (elapsed < best)) {
+            best = elapsed;
+        }
+    }
+
+    return best / ((double)NUM_REQUESTS * NUM_OPS_PER_REQUEST * 2) * 1e9;
+}
+
+int main(void) {
+    srand(0);
+    for (size_t i = 0; i < MAX_INPUT_SIZE; ++i) {
+        input_bytes[i] = (uint8_t)rand();
+    }
+    for (size_t i = 0; i < NUM_OPS_PER_REQUEST; ++i) {
+        input_sizes[i] = 1 + (size_t)rand() % MAX_INPUT_SIZE;
+        input_bytes[input_sizes[i] - 1] |= 1;
+    }
+
+    void* arena_buf = malloc(ARENA_SIZE);
+    if (arena_buf == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    B64Arena arena;
+    b64_arena_init(&arena, arena_buf, ARENA_SIZE);
+
+    double malloc_ns = measure(NULL);
+    double arena_ns = measure(&arena);
+
+    printf("Encoding/decoding %d small inputs (1-%d bytes) per request (best of %d):\n", NUM_OPS_PER_REQUEST, MAX_INPUT_SIZE, NUM_ITERATIONS);
+    printf("  malloc/free     : %8.1f ns/op\n", malloc_ns);
+    printf("  arena           : %8.1f ns/op (x%.2f)\n", arena_ns, malloc_ns / arena_ns);
+
+    free(arena_buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "b64.h"
+
+// The number of the inputs in a batch
+#define NUM_ITEMS 20000
+
+// Byte size range of the inputs
+#define MIN_ITEM_SIZE 16
+#define MAX_ITEM_SIZE 64
+
+// The number of iterations of each measurement
+#define NUM_ITERATIONS 10
+
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint8_t input_bytes[NUM_ITEMS * MAX_ITEM_SIZE];
+static B64Span srcs[NUM_ITEMS];
+static size_t offsets[NUM_ITEMS + 1];
+
+// Encode each input by b64_url_encode()
+static size_t encode_each(char* buf) {
+    size_t total_length = 0;
+    for (size_t i = 0; i < NUM_ITEMS; ++i) {
+        size_t length;
+        char* encoded_str = b64_url_encode(&length, srcs[i].data, srcs[i].size);
+        memcpy(&buf[total_length], encoded_str, length);
+        total_length += length;
+        free(encoded_str);
+    }
+
+    return total_length;
+}
+
+// Encode all inputs by b64_encode_batch()
+static size_t encode_batch(char* buf, const size_t buf_size) {
+    if (b64_encode_batch(offsets, buf, buf_size, srcs, NUM_ITEMS, &b64_url_alphabet, false, 0) != B64_SUCCESS) {
+        fprintf(stderr, "Error: batch encoding failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return offsets[NUM_ITEMS];
+}
+
+int main(void) {
+    srand(0);
+    size_t offset = 0;
+    for (size_t i = 0; i < NUM_ITEMS; ++i) {
+        srcs[i].data = &input_bytes[offset];
+        srcs[i].size = MIN_ITEM_SIZE + (size_t)rand() % (MAX_ITEM_SIZE - MIN_ITEM_SIZE + 1);
+        offset += srcs[i].size;
+    }
+    for (size_t i = 0; i < offset; ++i) {
+        input_bytes[i] = (uint8_t)rand();
+    }
+
+    const size_t buf_size = b64_get_batch_encoded_size(srcs, NUM_ITEMS, false, 0);
+    char* expected = malloc(buf_size);
+    char* buf = malloc(buf_size);
+    if ((expected == NULL) || (buf == NULL)) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    double each_best = 0.0;
+    double batch_best = 0.0;
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        double start = get_time();
+        size_t each_length = encode_each(expected);
+        double each_elapsed = get_time() - start;
+
+        start = get_time();
+        size_t batch_length = encode_batch(buf, buf_size);
+        double batch_elapsed = get_time() - start;
+
+        if ((each_length != batch_length) || (memcmp(expected, buf, batch_length) != 0)) {
+            fprintf(stderr, "Error: encoding result is wrong\n");
+            exit(EXIT_FAILURE);
+        }
+
+        if ((each_best == 0.0) || (each_elapsed < each_best)) {
+            each_best = each_elapsed;
+        }
+        if ((batch_best == 0.0) || (batch_elapsed < batch_best)) {
+            batch_best = batch_elapsed;
+        }
+    }
+
+    printf("Encoding %d inputs of %d-%d bytes (best of %d):\n", NUM_ITEMS, MIN_ITEM_SIZE, MAX_ITEM_SIZE, NUM_ITERATIONS);
+    printf("  b64_url_encode  : %8.1f ns/item\n", each_best / NUM_ITEMS * 1e9);
+    printf("  b64_encode_batch: %8.1f ns/item (x%.1f)\n", batch_best / NUM_ITEMS * 1e9, each_best / batch_best);
+
+    free(buf);
+    free(expected);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,285 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_TSC 1
+#else
+#define HAS_TSC 0
+#endif
+
+#include "b64.h"
+
+// Smallest byte size of the input
+#define MIN_INPUT_SIZE 16
+
+// Default largest byte size of the input, changed by --max-size
+#define DEFAULT_MAX_INPUT_SIZE (16 * 1024 * 1024)
+
+// Byte size of the buffer written to evict the input/output from the caches
+#define EVICTION_SIZE (64 * 1024 * 1024)
+
+// Byte size processed at least in a measurement with hot caches
+#define MIN_BYTES_PER_MEASUREMENT (16 * 1024 * 1024)
+
+// The number of the measurements, the best one is reported
+#define NUM_TRIALS 5
+
+// Misalignments of the input/output pointers in bytes
+static const size_t MISALIGNMENTS[] = { 0, 1 };
+
+/**************/
+// Codecs
+/**************/
+typedef struct Codec_tag {
+    const char* name;
+    const B64Alphabet* alphabet;
+    bool use_padding;
+    size_t line_length;
+} Codec;
+
+static const Codec CODECS[] = {
+    { "std", &b64_std_alphabet, true, 0 },
+    { "url", &b64_url_alphabet, false, 0 },
+    { "mime", &b64_std_alphabet, true, B64_MIME_LINE_LENGTH }
+};
+
+typedef enum OutputFormat_tag {
+    FORMAT_CSV,
+    FORMAT_JSON
+} OutputFormat;
+
+/*************/
+// Timers
+/*************/
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Get the timestamp counter, 0 if not available
+static uint64_t get_cycles(void) {
+#if HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*************/
+// Benchmark
+/*************/
+typedef struct Buffers_tag {
+    uint8_t* input_bytes; // Raw bytes, misaligned
+    char* encoded_str; // Encoded string, misaligned
+    uint8_t* decoded_bytes; // Output of the decoding, misaligned
+    char* output_str; // Output of the encoding, misaligned
+    size_t input_size;
+    size_t encoded_length;
+    size_t encoded_size; // Including a null character
+} Buffers;
+
+typedef struct Measurement_tag {
+    double mb_per_s;
+    double cycles_per_byte;
+} Measurement;
+
+static uint8_t* eviction_buf = NULL;
+
+// Write the large buffer to evict the others from the caches
+static void evict_caches(void) {
+    static uint8_t value = 0;
+    ++value;
+    memset(eviction_buf, value, EVICTION_SIZE);
+}
+
+// Run encoding or decoding once
+static void run(const Codec* codec, const bool encoding, const Buffers* bufs) {
+    B64Result result;
+    if (encoding) {
+        size_t length;
+        result = b64_encode_into(&length, bufs->output_str, bufs->encoded_size, bufs->input_bytes, bufs->input_size, codec->alphabet, codec->use_padding, codec->line_length);
+    } else {
+        size_t size;
+        result = b64_decode_into_n(&size, bufs->decoded_bytes, bufs->input_size, bufs->encoded_str, bufs->encoded_length, codec->alphabet, true);
+    }
+
+    if (result != B64_SUCCESS) {
+        fprintf(stderr, "Error: %s %s failed\n", codec->name, encoding ? "encoding" : "decoding");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Measure the throughput, the input is in the caches or evicted before each run
+static Measurement measure(const Codec* codec, const bool encoding, const Buffers* bufs, const bool hot) {
+    const size_t num_input_bytes = encoding ? bufs->input_size : bufs->encoded_length;
+
+    size_t num_runs = 1;
+    if (hot) {
+        num_runs = MIN_BYTES_PER_MEASUREMENT / num_input_bytes;
+        if (num_runs == 0) {
+            num_runs = 1;
+        }
+        // Warm up
+        run(codec, encoding, bufs);
+    }
+
+    Measurement best = { 0.0, 0.0 };
+    for (int i = 0; i < NUM_TRIALS; ++i) {
+        if (!hot) {
+            evict_caches();
+        }
+
+        double start = get_time();
+        uint64_t start_cycles = get_cycles();
+        for (size_t j = 0; j < num_runs; ++j) {
+            run(codec, encoding, bufs);
+        }
+        uint64_t cycles = get_cycles() - start_cycles;
+        double elapsed = get_time() - start;
+
+        const double num_bytes = (double)num_input_bytes * (double)num_runs;
+        double mb_per_s = num_bytes / elapsed / 1e6;
+        if (mb_per_s > best.mb_per_s) {
+            best.mb_per_s = mb_per_s;
+            best.cycles_per_byte = (double)cycles / num_bytes;
+        }
+    }
+
+    return best;
+}
+
+// Allocate the buffers with the misalignment and prepare the encoded string
+static bool prepare_buffers(Buffers* bufs, uint8_t* storage[4], const Codec* codec, const uint8_t* random_bytes, const size_t input_size, const size_t misalignment) {
+    bufs->input_size = input_size;
+    bufs->encoded_size = b64_get_encoded_size(input_size, codec->use_padding, codec->line_length);
+
+    storage[0] = malloc(input_size + misalignment);
+    storage[1] = malloc(bufs->encoded_size + misalignment);
+    storage[2] = malloc(input_size + misalignment);
+    storage[3] = malloc(bufs->encoded_size + misalignment);
+    if ((storage[0] == NULL) || (storage[1] == NULL) || (storage[2] == NULL) || (storage[3] == NULL)) {
+        return false;
+    }
+
+    bufs->input_bytes = &storage[0][misalignment];
+    bufs->encoded_str = (char*)&storage[1][misalignment];
+    bufs->decoded_bytes = &storage[2][misalignment];
+    bufs->output_str = (char*)&storage[3][misalignment];
+
+    memcpy(bufs->input_bytes, random_bytes, input_size);
+
+    return b64_encode_into(&bufs->encoded_length, bufs->encoded_str, bufs->encoded_size, bufs->input_bytes, input_size, codec->alphabet, codec->use_padding, codec->line_length) == B64_SUCCESS;
+}
+
+// Print a result in the format
+static void print_result(const OutputFormat format, const bool first, const Codec* codec, const bool encoding, const Buffers* bufs, const size_t misalignment, const bool hot, const Measurement* m) {
+    const char* operation = encoding ? "encode" : "decode";
+    const char* cache = hot ? "hot" : "cold";
+    const size_t num_input_bytes = encoding ? bufs->input_size : bufs->encoded_length;
+
+    if (format == FORMAT_CSV) {
+        printf("%s,%s,%zu,%zu,%zu,%s,%.1f,%.3f\n",
+            codec->name, operation, bufs->input_size, num_input_bytes, misalignment, cache, m->mb_per_s, m->cycles_per_byte);
+    } else {
+        printf("%s\n  {\"codec\": \"%s\", \"operation\": \"%s\", \"size\": %zu, \"input_bytes\": %zu, \"misalignment\": %zu, \"cache\": \"%s\", \"mb_per_s\": %.1f, \"cycles_per_byte\": %.3f}",
+            first ? "" : ",", codec->name, operation, bufs->input_size, num_input_bytes, misalignment, cache, m->mb_per_s, m->cycles_per_byte);
+    }
+    fflush(stdout);
+}
+
+static void print_usage(const char* name) {
+    fprintf(stderr, "usage: %s [--format csv|json] [--max-size bytes]\n", name);
+}
+
+int main(int argc, char* argv[]) {
+    OutputFormat format = FORMAT_CSV;
+    size_t max_input_size = DEFAULT_MAX_INPUT_SIZE;
+
+    for (int i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "--format") == 0) && ((i + 1) < argc)) {
+            ++i;
+            if (strcmp(argv[i], "csv") == 0) {
+                format = FORMAT_CSV;
+            } else if (strcmp(argv[i], "json") == 0) {
+                format = FORMAT_JSON;
+            } else {
+                print_usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+        } else if ((strcmp(argv[i], "--max-size") == 0) && ((i + 1) < argc)) {
+            ++i;
+            max_input_size = strtoull(argv[i], NULL, 0);
+            if (max_input_size < MIN_INPUT_SIZE) {
+                print_usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+        } else {
+            print_usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    uint8_t* random_bytes = malloc(max_input_size);
+    eviction_buf = malloc(EVICTION_SIZE);
+    if ((random_bytes == NULL) || (eviction_buf == NULL)) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    srand(0);
+    for (size_t i = 0; i < max_input_size; ++i) {
+        random_bytes[i] = (uint8_t)rand();
+    }
+
+    if (format == FORMAT_CSV) {
+        printf("codec,operation,size,input_bytes,misalignment,cache,mb_per_s,cycles_per_byte\n");
+    } else {
+        printf("[");
+    }
+
+    bool first = true;
+    for (size_t input_size = MIN_INPUT_SIZE; input_size <= max_input_size; input_size *= 4) {
+        for (size_t c = 0; c < (sizeof(CODECS) / sizeof(CODECS[0])); ++c) {
+            const Codec* codec = &CODECS[c];
+
+            for (size_t a = 0; a < (sizeof(MISALIGNMENTS) / sizeof(MISALIGNMENTS[0])); ++a) {
+                Buffers bufs;
+                uint8_t* storage[4] = { NULL, NULL, NULL, NULL };
+                if (!prepare_buffers(&bufs, storage, codec, random_bytes, input_size, MISALIGNMENTS[a])) {
+                    fprintf(stderr, "Error: failed to prepare %zu bytes\n", input_size);
+                    exit(EXIT_FAILURE);
+                }
+
+                for (int op = 0; op < 2; ++op) {
+                    for (int hot = 1; hot >= 0; --hot) {
+                        Measurement m = measure(codec, op == 0, &bufs, hot);
+                        print_result(format, first, codec, op == 0, &bufs, MISALIGNMENTS[a], hot, &m);
+                        first = false;
+                    }
+                }
+
+                for (int i = 0; i < 4; ++i) {
+                    free(storage[i]);
+                }
+            }
+        }
+    }
+
+    if (format == FORMAT_JSON) {
+        printf("\n]\n");
+    }
+
+    free(eviction_buf);
+    free(random_bytes);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "b64.h"
+
+// Byte size of the input of the benchmark
+#define INPUT_SIZE (8 * 1024 * 1024)
+
+// The number of iterations of each measurement
+#define NUM_ITERATIONS 10
+
+/*******************************************/
+// Reference decoder with the linear search
+/*******************************************/
+static const char legacy_encoding_table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Verify the input character by isalnum
+static bool legacy_is_valid_b64_char(const char c) {
+    return isalnum(c) || (c == '+') || (c == '/');
+}
+
+// Decode a character by searching the encoding table
+static uint8_t legacy_decode_b64_char(const char c) {
+    uint8_t index;
+    for (index = 0; index < 64; ++index) {
+        if (c == legacy_encoding_table[index]) {
+            return index;
+        }
+    }
+    return 64;
+}
+
+// Decode the NULL-terminated string in the same way as the former decode()
+static void* legacy_decode(size_t* size, const char* src) {
+    size_t length = strlen(src);
+    for (size_t i = 0; i < length; ++i) {
+        const char c = src[i];
+        if (!legacy_is_valid_b64_char(c) && (c != '\r') && (c != '\n') && (c != '=')) {
+            return NULL;
+        }
+    }
+
+    size_t num_encoding_chars = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (legacy_is_valid_b64_char(src[i])) {
+            num_encoding_chars++;
+        }
+    }
+    size_t decoded_size = num_encoding_chars / 4 * 3;
+    if ((num_encoding_chars % 4) == 1) {
+        return NULL;
+    } else if ((num_encoding_chars % 4) > 1) {
+        decoded_size += (num_encoding_chars % 4) - 1;
+    }
+
+    uint8_t* buf = malloc(decoded_size);
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    size_t buf_index = 0;
+    char chars[4];
+    int num_chars = 0;
+    for (const char* p = src; (*p != '\0') && (*p != '='); ++p) {
+        if (!legacy_is_valid_b64_char(*p)) {
+            continue;
+        }
+        chars[num_chars++] = *p;
+        if (num_chars == 4) {
+            // Each character is searched twice as the former decode_to_***_byte()
+            buf[buf_index++] = (legacy_decode_b64_char(chars[0]) << 2) | (legacy_decode_b64_char(chars[1]) >> 4);
+            buf[buf_index++] = (legacy_decode_b64_char(chars[1]) << 4) | (legacy_decode_b64_char(chars[2]) >> 2);
+            buf[buf_index++] = (legacy_decode_b64_char(chars[2]) << 6) | legacy_decode_b64_char(chars[3]);
+            num_chars = 0;
+        }
+    }
+    if (num_chars >= 2) {
+        buf[buf_index++] = (legacy_decode_b64_char(chars[0]) << 2) | (legacy_decode_b64_char(chars[1]) >> 4);
+    }
+    if (num_chars == 3) {
+        buf[buf_index++] = (legacy_decode_b64_char(chars[1]) << 4) | (legacy_decode_b64_char(chars[2]) >> 2);
+    }
+
+    *size = decoded_size;
+
+    return buf;
+}
+
+/*************/
+// Benchmark
+/*************/
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Measure the throughput of the decoder in MB/s
+static double measure(void* (*decoder)(size_t*, const char*), const char* src, const uint8_t* expected, const size_t expected_size) {
+    double best = 0.0;
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        size_t size = 0;
+        double start = get_time();
+        uint8_t* decoded = decoder(&size, src);
+        double elapsed = get_time() - start;
+
+        if ((decoded == NULL) || (size != expected_size) || (memcmp(decoded, expected, size) != 0)) {
+            fprintf(stderr, "Error: decoding result is wrong\n");
+            exit(EXIT_FAILURE);
+        }
+        free(decoded);
+
+        double throughput = (double)strlen(src) / elapsed / 1e6;
+        if (throughput > best) {
+            best = throughput;
+        }
+    }
+
+    return best;
+}
+
+int main(void) {
+    uint8_t* input_bytes = malloc(INPUT_SIZE);
+    if (input_bytes == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    srand(0);
+    for (size_t i = 0; i < INPUT_SIZE; ++i) {
+        input_bytes[i] = (uint8_t)rand();
+    }
+
+    size_t length;
+    char* encoded_str = b64_std_encode(&length, input_bytes, INPUT_SIZE);
+    if (encoded_str == NULL) {
+        fprintf(stderr, "Error: failed to encode the input\n");
+        exit(EXIT_FAILURE);
+    }
+
+    double legacy = measure(legacy_decode, encoded_str, input_bytes, INPUT_SIZE);
+    double table = measure(b64_std_decode, encoded_str, input_bytes, INPUT_SIZE);
+
+    printf("Decoding %lu characters (best of %d):\n", length, NUM_ITERATIONS);
+    printf("  linear search   : %8.1f MB/s\n", legacy);
+    printf("  b64_std_decode  : %8.1f MB/s (x%.1f)\n", table, table / legacy);
+
+    free(encoded_str);
+    free(input_bytes);
+
+    return EXIT_SUCCESS;
+}
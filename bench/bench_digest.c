@@ -0,0 +1,147 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "b64.h"
+
+// Byte size of the raw bytes fitting in the caches
+#define CACHED_INPUT_SIZE (4 * 1024 * 1024)
+
+// Default byte size of the raw bytes well above the last level cache, changed by --max-size
+#define DEFAULT_MAX_INPUT_SIZE (256 * 1024 * 1024)
+
+// The number of iterations of each measurement
+#define NUM_ITERATIONS 20
+
+// The number of iterations of each measurement of the input above the caches
+#define NUM_LARGE_ITERATIONS 3
+
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Decode and then compute the checksum over the decoded bytes
+static void decode_then_checksum(uint8_t* buf, const size_t buf_size, const char* encoded_str, const size_t length, const unsigned int digest_types, B64Digest* digest) {
+    size_t size;
+    if (b64_decode_into_n(&size, buf, buf_size, encoded_str, length, &b64_std_alphabet, true) != B64_SUCCESS) {
+        fprintf(stderr, "Error: decoding failed\n");
+        exit(EXIT_FAILURE);
+    }
+    digest->crc32c = ((digest_types & B64_DIGEST_CRC32C) != 0) ? b64_crc32c(0, buf, size) : 0;
+    digest->xxh64 = ((digest_types & B64_DIGEST_XXH64) != 0) ? b64_xxh64(buf, size, 0) : 0;
+}
+
+// Decode with the checksum in the same pass
+static void decode_with_digest(uint8_t* buf, const size_t buf_size, const char* encoded_str, const size_t length, const unsigned int digest_types, B64Digest* digest) {
+    size_t size;
+    if (b64_decode_into_with_digest_n(&size, buf, buf_size, encoded_str, length, &b64_std_alphabet, true, digest_types, digest) != B64_SUCCESS) {
+        fprintf(stderr, "Error: decoding failed\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+typedef void (*DecodeFunc)(uint8_t*, const size_t, const char*, const size_t, const unsigned int, B64Digest*);
+
+// Measure the throughput of the decoding in MB/s of the encoded string
+static double measure(DecodeFunc func, const int num_iterations, uint8_t* buf, const size_t buf_size, const char* encoded_str, const size_t length, const unsigned int digest_types, B64Digest* digest) {
+    double best = 0.0;
+    for (int i = 0; i < num_iterations; ++i) {
+        double start = get_time();
+        func(buf, buf_size, encoded_str, length, digest_types, digest);
+        double elapsed = get_time() - start;
+        if ((best == 0.0) || (elapsed < best)) {
+            best = elapsed;
+        }
+    }
+
+    return (double)length / best / 1e6;
+}
+
+// Measure the decoding of the input with each checksum
+static void measure_all(const uint8_t* random_bytes, const size_t input_size) {
+    uint8_t* buf = malloc(input_size);
+    if (buf == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t length;
+    char* encoded_str = b64_std_encode(&length, random_bytes, input_size);
+    if (encoded_str == NULL) {
+        fprintf(stderr, "Error: encoding failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    static const struct {
+        const char* name;
+        unsigned int types;
+    } digests[] = {
+        { "crc32c", B64_DIGEST_CRC32C },
+        { "xxh64", B64_DIGEST_XXH64 },
+        { "crc32c+xxh64", B64_DIGEST_CRC32C | B64_DIGEST_XXH64 }
+    };
+
+    // The input above the caches is read from the memory in every iteration
+    const int num_iterations = (input_size <= CACHED_INPUT_SIZE) ? NUM_ITERATIONS : NUM_LARGE_ITERATIONS;
+
+    printf("Decoding %zu bytes with the checksum (best of %d):\n", input_size, num_iterations);
+    for (size_t i = 0; i < (sizeof(digests) / sizeof(digests[0])); ++i) {
+        B64Digest separate_digest;
+        B64Digest fused_digest;
+        double separate = measure(decode_then_checksum, num_iterations, buf, input_size, encoded_str, length, digests[i].types, &separate_digest);
+        double fused = measure(decode_with_digest, num_iterations, buf, input_size, encoded_str, length, digests[i].types, &fused_digest);
+        if ((separate_digest.crc32c != fused_digest.crc32c) || (separate_digest.xxh64 != fused_digest.xxh64)) {
+            fprintf(stderr, "Error: checksums mismatch\n");
+            exit(EXIT_FAILURE);
+        }
+
+        printf("  %-12s separate: %8.1f MB/s, fused: %8.1f MB/s (x%.2f)\n", digests[i].name, separate, fused, fused / separate);
+    }
+
+    free(encoded_str);
+    free(buf);
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_input_size = DEFAULT_MAX_INPUT_SIZE;
+
+    // Other arguments are for the other benchmarks, as BENCH_ARGS is passed to all
+    for (int i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "--max-size") == 0) && ((i + 1) < argc)) {
+            ++i;
+            max_input_size = strtoull(argv[i], NULL, 0);
+            if (max_input_size == 0) {
+                fprintf(stderr, "usage: %s [--max-size bytes]\n", argv[0]);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    uint8_t* random_bytes = malloc(max_input_size);
+    if (random_bytes == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    srand(0);
+    for (size_t i = 0; i < max_input_size; ++i) {
+        random_bytes[i] = (uint8_t)rand();
+    }
+
+    // In the caches, and above the last level cache
+    if (max_input_size > CACHED_INPUT_SIZE) {
+        measure_all(random_bytes, CACHED_INPUT_SIZE);
+    }
+    measure_all(random_bytes, max_input_size);
+
+    free(random_bytes);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "b64.h"
+
+// The number of the distinct inputs of each size
+#define NUM_INPUTS 1024
+
+// The number of the rounds over the inputs in a measurement
+#define NUM_ROUNDS 200
+
+// The number of iterations of each measurement
+#define NUM_ITERATIONS 5
+
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Methods of encoding/decoding
+typedef enum {
+    METHOD_ALLOC, // b64_url_encode()/b64_url_decode_n()
+    METHOD_INTO, // b64_encode_into()/b64_decode_into_n()
+    METHOD_SMALL // b64_encode_small()/b64_decode_small()
+} Method;
+
+static const char* encode_names[] = { "b64_url_encode  ", "b64_encode_into ", "b64_encode_small" };
+static const char* decode_names[] = { "b64_url_decode_n", "b64_decode_into ", "b64_decode_small" };
+
+static uint8_t input_bytes[NUM_INPUTS][B64_SMALL_MAX_SIZE];
+static char encoded_strs[NUM_INPUTS][B64_SMALL_MAX_LENGTH + 1];
+
+// Fail the benchmark
+static void fail(const char* message) {
+    fprintf(stderr, "Error: %s\n", message);
+    exit(EXIT_FAILURE);
+}
+
+// Encode all inputs of the size, return the sum of the lengths
+static size_t encode_all(const Method method, const size_t src_size) {
+    size_t total_length = 0;
+    for (size_t i = 0; i < NUM_INPUTS; ++i) {
+        size_t length = 0;
+        if (method == METHOD_ALLOC) {
+            char* encoded_str = b64_url_encode(&length, input_bytes[i], src_size);
+            if (encoded_str == NULL) {
+                fail("encoding failed");
+            }
+            encoded_strs[i][0] = encoded_str[0];
+            free(encoded_str);
+        } else if (method == METHOD_INTO) {
+            if (b64_encode_into(&length, encoded_strs[i], sizeof(encoded_strs[i]), input_bytes[i], src_size, &b64_url_alphabet, false, 0) != B64_SUCCESS) {
+                fail("encoding failed");
+            }
+        } else {
+            if (b64_encode_small(&length, encoded_strs[i], sizeof(encoded_strs[i]), input_bytes[i], src_size, &b64_url_alphabet, false) != B64_SUCCESS) {
+                fail("encoding failed");
+            }
+        }
+        total_length += length;
+    }
+
+    return total_length;
+}
+
+// Decode all encoded strings of the length, return the sum of the sizes
+static size_t decode_all(const Method method, const size_t src_length) {
+    uint8_t buf[B64_SMALL_MAX_SIZE];
+    size_t total_size = 0;
+    for (size_t i = 0; i < NUM_INPUTS; ++i) {
+        size_t size = 0;
+        if (method == METHOD_ALLOC) {
+            uint8_t* decoded_bytes = b64_url_decode_n(&size, encoded_strs[i], src_length);
+            if (decoded_bytes == NULL) {
+                fail("decoding failed");
+            }
+            free(decoded_bytes);
+        } else if (method == METHOD_INTO) {
+            if (b64_decode_into_n(&size, buf, sizeof(buf), encoded_strs[i], src_length, &b64_url_alphabet, true) != B64_SUCCESS) {
+                fail("decoding failed");
+            }
+        } else {
+            if (b64_decode_small(&size, buf, sizeof(buf), encoded_strs[i], src_length, &b64_url_alphabet) != B64_SUCCESS) {
+                fail("decoding failed");
+            }
+        }
+        total_size += size;
+    }
+
+    return total_size;
+}
+
+// Measure the time per encoding (or decoding) in nanoseconds
+static double measure(const Method method, const size_t src_size, const size_t src_length, const int decoding) {
+    const size_t expected = decoding ? (src_size * NUM_INPUTS) : (src_length * NUM_INPUTS);
+
+    double best = 0.0;
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        double start = get_time();
+        for (int r = 0; r < NUM_ROUNDS; ++r) {
+            const size_t total = decoding ? decode_all(method, src_length) : encode_all(method, src_size);
+            if (total != expected) {
+                fail("encoding/decoding result is wrong");
+            }
+        }
+        double elapsed = get_time() - start;
+        if ((best == 0.0) || (elapsed < best)) {
+            best = elapsed;
+        }
+    }
+
+    return best / ((double)NUM_INPUTS * NUM_ROUNDS) * 1e9;
+}
+
+int main(void) {
+    srand(0);
+    for (size_t i = 0; i < NUM_INPUTS; ++i) {
+        for (size_t j = 0; j < B64_SMALL_MAX_SIZE; ++j) {
+            input_bytes[i][j] = (uint8_t)rand();
+        }
+    }
+
+    // UUIDs, SHA-1/SHA-256 digests and keys
+    const size_t sizes[] = { 16, 20, 32, 64 };
+
+    printf("URL-safe encoding/decoding of %d inputs of the fixed sizes (best of %d):\n", NUM_INPUTS, NUM_ITERATIONS);
+    for (size_t s = 0; s < (sizeof(sizes) / sizeof(sizes[0])); ++s) {
+        const size_t src_size = sizes[s];
+        const size_t src_length = b64_get_encoded_size(src_size, false, 0) - 1;
+
+        // Encoded strings for the decoding
+        encode_all(METHOD_SMALL, src_size);
+
+        double encode_ns[3];
+        double decode_ns[3];
+        for (int m = METHOD_ALLOC; m <= METHOD_SMALL; ++m) {
+            encode_ns[m] = measure((Method)m, src_size, src_length, 0);
+            decode_ns[m] = measure((Method)m, src_size, src_length, 1);
+        }
+
+        printf("  %2zu bytes (%2zu characters):\n", src_size, src_length);
+        for (int m = METHOD_ALLOC; m <= METHOD_SMALL; ++m) {
+            printf("    %s: %6.1f ns/op (x%.1f)\n", encode_names[m], encode_ns[m], encode_ns[METHOD_ALLOC] / encode_ns[m]);
+        }
+        for (int m = METHOD_ALLOC; m <= METHOD_SMALL; ++m) {
+            printf("    %s: %6.1f ns/op (x%.1f)\n", decode_names[m], decode_ns[m], decode_ns[METHOD_ALLOC] / decode_ns[m]);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
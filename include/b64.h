@@ -9,6 +9,127 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Line length of Base64 encoding for MIME
+ */
+#define B64_MIME_LINE_LENGTH 76
+
+/**
+ * @brief Result of encoding/decoding
+ */
+typedef enum B64Result_tag {
+    B64_SUCCESS = 0, // Succeeded
+    B64_ERROR_INVALID_ARGUMENT, // Invalid argument, e.g. NULL pointer
+    B64_ERROR_EMPTY_INPUT, // No input bytes/encoding characters
+    B64_ERROR_INVALID_CHAR, // Invalid character in the input string
+    B64_ERROR_INVALID_LENGTH, // Invalid number of the encoding characters
+    B64_ERROR_BUFFER_TOO_SMALL, // Output buffer is too small
+    B64_ERROR_OUT_OF_MEMORY, // Failed to allocate memory
+    B64_ERROR_INVALID_PADDING, // Missing, excess or misplaced padding in the strict decoding
+    B64_ERROR_NON_ZERO_TRAILING_BITS // Unused bits of the last character are not 0 in the strict decoding
+} B64Result;
+
+/**
+ * @brief Detail of the result of the decoding
+ */
+typedef struct B64Error_tag {
+    B64Result code; // Result of the decoding
+    size_t offset; // Offset of the first offending character, the input length if the error is at the end of the input
+    size_t decoded_size; // Byte size of the decoded byte array before the error
+} B64Error;
+
+/**
+ * @brief Get the description of the result
+ *
+ * @param[in] result Result
+ * @return Null-terminated static string describing the result
+ */
+const char* b64_result_string(const B64Result result);
+
+/**
+ * @brief Base64 alphabet with the encoding/decoding tables
+ *
+ * It is immutable after the initialization, so an alphabet can be shared
+ * among threads without locking.
+ */
+typedef struct B64Alphabet_tag {
+    char encoding_table[64]; // Encoding character of each 6-bit value
+    uint8_t decoding_table[256]; // 6-bit value of each character, 0xff for characters out of the alphabet
+    char encoding_pair_table[4096][2]; // 2 encoding characters of each 12-bit value
+    uint32_t shifted_decoding_tables[4][256]; // 6-bit value shifted to its position in a 24-bit block for each character position, bit 24 is set for characters out of the alphabet
+} B64Alphabet;
+
+/** Alphabet for the standard encoding (62nd/63rd encoding characters: '+'/'/') */
+extern const B64Alphabet b64_std_alphabet;
+
+/** Alphabet for the URL-safe encoding (62nd/63rd encoding characters: '-'/'_') */
+extern const B64Alphabet b64_url_alphabet;
+
+/**
+ * @brief Initialize an alphabet with the specified 62nd/63rd encoding characters
+ *
+ * @param[out] alphabet Alphabet to be initialized
+ * @param[in] last_2_encoding_chars 62nd/63rd encoding characters
+ * @retval true Initialization succeeded
+ * @retval false The characters are alphanumeric, null, padding ('='), CR/LF or identical
+ */
+bool b64_init_alphabet(B64Alphabet* alphabet, const char last_2_encoding_chars[2]);
+
+/**
+ * @brief Allocator of the encoded string/decoded byte array
+ */
+typedef struct B64Allocator_tag {
+    void* (*alloc)(size_t size, void* context); // Allocate memory of the size, NULL on failure
+    void (*free)(void* ptr, void* context); // Free memory allocated by alloc
+    void* context; // User context passed to alloc/free
+} B64Allocator;
+
+/** Allocator by malloc()/free(), used by the functions without an allocator */
+extern const B64Allocator b64_default_allocator;
+
+/**
+ * @brief Bump-pointer arena on a buffer provided by the user
+ *
+ * Allocations are released at once by b64_arena_reset().
+ */
+typedef struct B64Arena_tag {
+    uint8_t* buf; // Pointer to the buffer
+    size_t size; // Byte size of the buffer
+    size_t used; // Byte size used from the beginning of the buffer
+    size_t last; // Offset of the last allocation
+} B64Arena;
+
+/**
+ * @brief Initialize an arena on the buffer
+ *
+ * @param[out] arena Arena to be initialized
+ * @param[in] buf Pointer to the buffer, owned by the user
+ * @param[in] size Byte size of the buffer
+ */
+void b64_arena_init(B64Arena* arena, void* buf, const size_t size);
+
+/**
+ * @brief Release all allocations of the arena
+ *
+ * @param[in,out] arena Arena
+ */
+void b64_arena_reset(B64Arena* arena);
+
+/**
+ * @brief Get the allocator allocating from the arena
+ *
+ * The memory is aligned by 16 bytes. Freeing is no-op except for the last allocation,
+ * which is returned to the arena (e.g. when decoding failed).
+ *
+ * @param[in] arena Arena
+ * @return Allocator with the arena as the context
+ */
+B64Allocator b64_arena_allocator(B64Arena* arena);
+
 /**
  * @brief Encode byte array Base64 encoding
  *
@@ -19,10 +140,67 @@
  * @param[in] use_padding Use padding ('=')
  * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
  * @return Pointer to the null-terminated encoded string, dynamically allocated on the heap
- * @retval NULL Encoding failed
+ * @retval NULL Encoding failed, or the 62nd/63rd encoding characters are alphanumeric, null or identical
+ * @note Padding ('=') and CR/LF are accepted as the 62nd/63rd encoding characters,
+ *       although the encoded string can't be decoded, unlike b64_init_alphabet()
  */
 char* b64_encode(size_t* length, const void* src, const size_t src_size, char last_2_encoding_chars[2], const bool use_padding, const size_t line_length);
 
+/**
+ * @brief Encode byte array Base64 encoding with the alphabet
+ *
+ * @param[out] length Length of the encoded string
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @return Pointer to the null-terminated encoded string, dynamically allocated on the heap
+ * @retval NULL Encoding failed
+ */
+char* b64_encode_with_alphabet(size_t* length, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length);
+
+/**
+ * @brief Encode byte array Base64 encoding with the alphabet into memory by the allocator
+ *
+ * @param[out] length Length of the encoded string
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @param[in] allocator Allocator of the encoded string
+ * @return Pointer to the null-terminated encoded string, allocated by the allocator
+ * @retval NULL Encoding failed
+ */
+char* b64_encode_with_allocator(size_t* length, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, const B64Allocator* allocator);
+
+/**
+ * @brief Get the byte size of the buffer required for Base64 encoding
+ *
+ * @param[in] src_size Byte size of the input
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @return Byte size of the encoded string, including a null character
+ * @retval 0 The input is empty
+ */
+size_t b64_get_encoded_size(const size_t src_size, const bool use_padding, const size_t line_length);
+
+/**
+ * @brief Encode byte array Base64 encoding into the buffer
+ *
+ * @param[out] length Length of the encoded string
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_encoded_size()
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @return Result of the encoding, the null-terminated encoded string is written in dest on B64_SUCCESS
+ */
+B64Result b64_encode_into(size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length);
+
 /**
  * @brief Encode byte array by standard Base64 encoding
  *
@@ -56,6 +234,70 @@ char* b64_url_encode(size_t* length, const void* src, const size_t src_size);
  */
 char* b64_mime_encode(size_t* length, const void* src, const size_t src_size);
 
+/**
+ * @brief State of streaming Base64 encoding
+ */
+typedef struct B64EncodeState_tag {
+    const B64Alphabet* alphabet; // Alphabet used for the encoding
+    bool use_padding; // Use padding ('=')
+    size_t line_length; // Length to insert linebreak (CRLF) (no linebreaks with 0)
+    size_t column; // The number of characters in the current line
+    uint8_t remaining_bytes[3]; // Input bytes not encoded yet
+    size_t num_remaining_bytes; // The number of the remaining bytes, 0 to 2
+} B64EncodeState;
+
+/**
+ * @brief Maximum length of the string written by b64_encode_final()
+ */
+#define B64_ENCODE_FINAL_SIZE 6
+
+/**
+ * @brief Initialize the state of streaming Base64 encoding
+ *
+ * @param[out] state State to be initialized
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ */
+void b64_encode_init(B64EncodeState* state, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length);
+
+/**
+ * @brief Get the length of the string written by b64_encode_update()
+ *
+ * @param[in] state State of the encoding
+ * @param[in] src_size Byte size of the next input
+ * @return Exact length of the encoded string for the input
+ */
+size_t b64_get_encode_update_size(const B64EncodeState* state, const size_t src_size);
+
+/**
+ * @brief Encode a chunk of the input in streaming Base64 encoding
+ *
+ * Up to 2 bytes not filling a 3-byte block are kept in the state until the next call.
+ *
+ * @param[in,out] state State of the encoding
+ * @param[out] length Length of the encoded string
+ * @param[out] dest Pointer to the output buffer, not null-terminated
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_encode_update_size()
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @return Result of the encoding
+ */
+B64Result b64_encode_update(B64EncodeState* state, size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size);
+
+/**
+ * @brief Finish streaming Base64 encoding
+ *
+ * The encoded string through the stream is identical to the one by b64_encode_with_alphabet().
+ *
+ * @param[in,out] state State of the encoding
+ * @param[out] length Length of the encoded string
+ * @param[out] dest Pointer to the output buffer, not null-terminated
+ * @param[in] dest_size Byte size of the output buffer, B64_ENCODE_FINAL_SIZE is enough
+ * @return Result of the encoding
+ */
+B64Result b64_encode_final(B64EncodeState* state, size_t* length, char* dest, const size_t dest_size);
+
 /**
  * @brief Decode standard Base64-encoded string
  *
@@ -64,10 +306,522 @@ char* b64_mime_encode(size_t* length, const void* src, const size_t src_size);
  * @param[in] last_2_encoding_chars 62nd/63rd encoding characters
  * @param[in] validate Validate characters in the input string
  * @return Pointer to the decoded byte array, dynamically allocated on the heap
- * @retval NULL Decoding failed
+ * @retval NULL Decoding failed, or the 62nd/63rd encoding characters are not accepted by b64_init_alphabet()
  */
 void* b64_decode(size_t* size, const char* src, char last_2_encoding_chars[2], const bool validate);
 
+/**
+ * @brief Decode Base64-encoded string with the length
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] last_2_encoding_chars 62nd/63rd encoding characters
+ * @param[in] validate Validate characters in the input string
+ * @return Pointer to the decoded byte array, dynamically allocated on the heap
+ * @retval NULL Decoding failed, or the 62nd/63rd encoding characters are not accepted by b64_init_alphabet()
+ */
+void* b64_decode_n(size_t* size, const char* src, const size_t src_length, char last_2_encoding_chars[2], const bool validate);
+
+/**
+ * @brief Decode Base64-encoded string with the alphabet
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @return Pointer to the decoded byte array, dynamically allocated on the heap
+ * @retval NULL Decoding failed
+ */
+void* b64_decode_with_alphabet(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Decode Base64-encoded string with the length and the alphabet
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @return Pointer to the decoded byte array, dynamically allocated on the heap
+ * @retval NULL Decoding failed
+ */
+void* b64_decode_with_alphabet_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Decode Base64-encoded string with the alphabet into memory by the allocator
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[in] allocator Allocator of the decoded byte array
+ * @return Pointer to the decoded byte array, allocated by the allocator
+ * @retval NULL Decoding failed
+ */
+void* b64_decode_with_allocator(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator);
+
+/**
+ * @brief Decode Base64-encoded string with the alphabet and the length into memory by the allocator
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[in] allocator Allocator of the decoded byte array
+ * @return Pointer to the decoded byte array, allocated by the allocator
+ * @retval NULL Decoding failed
+ */
+void* b64_decode_with_allocator_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator);
+
+/**
+ * @brief Decode Base64-encoded string with the alphabet, reporting the detail of an error
+ *
+ * The detail is obtained in the same pass as the decoding.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[out] error Detail of the result, written on both success and failure
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_with_error(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate, B64Error* error);
+
+/**
+ * @brief Decode Base64-encoded string with the length and the alphabet, reporting the detail of an error
+ *
+ * The detail is obtained in the same pass as the decoding.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[out] error Detail of the result, written on both success and failure
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_with_error_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, B64Error* error);
+
+/**
+ * @brief Decode Base64-encoded string with the alphabet into memory by the allocator, reporting the detail of an error
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[in] allocator Allocator of the decoded byte array
+ * @param[out] error Detail of the result, written on both success and failure
+ * @return Pointer to the decoded byte array, allocated by the allocator
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_with_allocator_and_error(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator, B64Error* error);
+
+/**
+ * @brief Decode Base64-encoded string with the length and the alphabet into memory by the allocator, reporting the detail of an error
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[in] allocator Allocator of the decoded byte array
+ * @param[out] error Detail of the result, written on both success and failure
+ * @return Pointer to the decoded byte array, allocated by the allocator
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_with_allocator_and_error_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator, B64Error* error);
+
+/**
+ * @brief State of streaming Base64 decoding
+ */
+typedef struct B64DecodeState_tag {
+    const B64Alphabet* alphabet; // Alphabet used for the decoding
+    bool validate; // Validate characters in the input string
+    uint8_t decoded_values[4]; // 6-bit values not filling a block yet
+    size_t num_decoded_values; // The number of the 6-bit values, 0 to 3
+    bool padding_found; // Padding has been found
+    size_t decoded_size; // Byte size of the decoded byte array so far
+    size_t num_read_chars; // The number of the characters read so far, up to the offending character on error
+    bool strict; // Accept only the canonical form
+    bool require_padding; // Padding is required (or prohibited) in the strict decoding
+    size_t num_paddings; // The number of the padding characters in the strict decoding
+} B64DecodeState;
+
+/**
+ * @brief Maximum byte size of the decoded byte array written by b64_decode_final()
+ */
+#define B64_DECODE_FINAL_SIZE 2
+
+/**
+ * @brief Initialize the state of streaming Base64 decoding
+ *
+ * @param[out] state State to be initialized
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ */
+void b64_decode_init(B64DecodeState* state, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Initialize the state of streaming Base64 decoding in the strict mode
+ *
+ * Only the canonical form, the output of the encoding without linebreaks, is accepted.
+ *
+ * @param[out] state State to be initialized
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ */
+void b64_decode_init_strict(B64DecodeState* state, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief Get the byte size of the buffer required for b64_decode_update()
+ *
+ * @param[in] state State of the decoding
+ * @param[in] src_length Length of the next input string
+ * @return Upper bound of the byte size of the decoded byte array for the input
+ */
+size_t b64_get_decode_update_size(const B64DecodeState* state, const size_t src_length);
+
+/**
+ * @brief Decode a chunk of the input in streaming Base64 decoding
+ *
+ * Up to 3 characters not filling a 4-character block are kept in the state until the next call,
+ * so the input can be split at any position, e.g. between CR and LF.
+ * The state is not usable after an error.
+ *
+ * @param[in,out] state State of the decoding
+ * @param[out] size Byte size of the decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decode_update_size()
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @return Result of the decoding
+ */
+B64Result b64_decode_update(B64DecodeState* state, size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length);
+
+/**
+ * @brief Finish streaming Base64 decoding
+ *
+ * The decoded byte array through the stream is identical to the one by b64_decode_with_alphabet().
+ *
+ * @param[in,out] state State of the decoding
+ * @param[out] size Byte size of the decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, B64_DECODE_FINAL_SIZE is enough
+ * @return Result of the decoding
+ */
+B64Result b64_decode_final(B64DecodeState* state, size_t* size, void* dest, const size_t dest_size);
+
+/**
+ * @brief Get the byte size of Base64-decoded byte array
+ *
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @return Exact byte size of the decoded byte array
+ * @retval 0 The input is not decodable
+ */
+size_t b64_get_decoded_size(const char* src, const B64Alphabet* alphabet);
+
+/**
+ * @brief Get the byte size of Base64-decoded byte array with the length
+ *
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @return Exact byte size of the decoded byte array
+ * @retval 0 The input is not decodable
+ */
+size_t b64_get_decoded_size_n(const char* src, const size_t src_length, const B64Alphabet* alphabet);
+
+/**
+ * @brief Get the byte size of Base64-decoded byte array without linebreaks in O(1)
+ *
+ * The size is obtained from the length and the trailing padding without reading the other characters,
+ * so the input must consist of only the encoding characters and the padding (e.g. not MIME).
+ * The size is exact for the canonical form, which has the padding only at the end.
+ * Padding in the middle (e.g. "QQ==QQ==") is not detected, the size is an upper bound then.
+ *
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @return Byte size of the decoded byte array, exact for the canonical form
+ * @retval 0 The length or the trailing padding is not decodable
+ */
+size_t b64_get_decoded_size_unwrapped(const char* src, const size_t src_length);
+
+/**
+ * @brief Decode Base64-encoded string into the buffer
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size()
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_decode_into(size_t* size, void* dest, const size_t dest_size, const char* src, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Decode Base64-encoded string with the length into the buffer
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size_n()
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_decode_into_n(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Decode null-terminated Base64-encoded string in place
+ *
+ * The decoded byte array overwrites the beginning of the string, without additional memory.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in,out] buf Pointer to the null-terminated Base64-encoded string, overwritten by the decoded byte array
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string, non encoding characters (e.g. whitespaces) are skipped if false
+ * @return Result of the decoding, the decoded byte array is written in buf on B64_SUCCESS
+ */
+B64Result b64_decode_in_place(size_t* size, char* buf, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Decode Base64-encoded string with the length in place
+ *
+ * The decoded byte array overwrites the beginning of the string, without additional memory.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in,out] buf Pointer to the Base64-encoded string, overwritten by the decoded byte array
+ * @param[in] length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string, non encoding characters (e.g. whitespaces) are skipped if false
+ * @return Result of the decoding, the decoded byte array is written in buf on B64_SUCCESS
+ */
+B64Result b64_decode_in_place_n(size_t* size, char* buf, const size_t length, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Maximum byte size of the input of b64_encode_small()
+ */
+#define B64_SMALL_MAX_SIZE 64
+
+/**
+ * @brief Maximum length of the input of b64_decode_small(), B64_SMALL_MAX_SIZE bytes encoded with padding
+ */
+#define B64_SMALL_MAX_LENGTH 88
+
+/**
+ * @brief Encode a small byte array Base64 encoding into the buffer without linebreaks
+ *
+ * Unrolled routines specialized for 16, 20, 32 and 64 bytes (UUIDs, SHA-1/SHA-256 digests and keys) are selected by the size.
+ *
+ * @param[out] length Length of the encoded string
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_encoded_size() without linebreaks
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input, up to B64_SMALL_MAX_SIZE
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @return Result of the encoding, the null-terminated encoded string is written in dest on B64_SUCCESS
+ * @retval B64_ERROR_INVALID_LENGTH The input is larger than B64_SMALL_MAX_SIZE
+ */
+B64Result b64_encode_small(size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief Decode a small Base64-encoded string without linebreaks into the buffer
+ *
+ * Unrolled routines specialized for the encoded 16, 20, 32 and 64 bytes are selected by the length.
+ * All characters except up to 2 trailing paddings must be encoding characters.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size_unwrapped()
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string, up to B64_SMALL_MAX_LENGTH
+ * @param[in] alphabet Alphabet used for the decoding
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ * @retval B64_ERROR_INVALID_LENGTH The input is longer than B64_SMALL_MAX_LENGTH, or its length is not decodable
+ */
+B64Result b64_decode_small(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet);
+
+/**
+ * @brief Decode null-terminated Base64-encoded string in the strict mode
+ *
+ * Only the canonical form, the output of the encoding without linebreaks, is accepted:
+ * the input is rejected by linebreaks, missing, excess or misplaced padding,
+ * and non-zero unused bits of the last character, in the same pass as the decoding.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_strict(size_t* size, const char* src, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief Decode Base64-encoded string with the length in the strict mode
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_strict_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief Decode null-terminated Base64-encoded string into memory by the allocator in the strict mode
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ * @param[in] allocator Allocator of the decoded byte array
+ * @return Pointer to the decoded byte array, allocated by the allocator
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_strict_with_allocator(size_t* size, const char* src, const B64Alphabet* alphabet, const bool use_padding, const B64Allocator* allocator);
+
+/**
+ * @brief Decode Base64-encoded string with the length into memory by the allocator in the strict mode
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ * @param[in] allocator Allocator of the decoded byte array
+ * @return Pointer to the decoded byte array, allocated by the allocator
+ * @retval NULL if decoding failed
+ */
+void* b64_decode_strict_with_allocator_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool use_padding, const B64Allocator* allocator);
+
+/**
+ * @brief Decode null-terminated Base64-encoded string into the buffer in the strict mode
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size()
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_decode_into_strict(size_t* size, void* dest, const size_t dest_size, const char* src, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief Decode Base64-encoded string with the length into the buffer in the strict mode
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size_n()
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] use_padding Padding is required, or prohibited if false
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_decode_into_strict_n(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief CRC32C (Castagnoli) of the raw bytes, computed by b64_crc32c()
+ */
+#define B64_DIGEST_CRC32C 0x1
+
+/**
+ * @brief XXH64 with seed 0 of the raw bytes, computed by b64_xxh64()
+ */
+#define B64_DIGEST_XXH64 0x2
+
+/**
+ * @brief Checksums of the raw bytes
+ */
+typedef struct B64Digest_tag {
+    uint32_t crc32c; // CRC32C, 0 if not computed
+    uint64_t xxh64; // XXH64, 0 if not computed
+} B64Digest;
+
+/**
+ * @brief Compute CRC32C (Castagnoli) of the data, by SSE4.2 if available
+ *
+ * @param[in] crc CRC32C of the preceding data, 0 for the beginning
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+ * @return CRC32C of the data following the preceding data
+ */
+uint32_t b64_crc32c(const uint32_t crc, const void* data, const size_t size);
+
+/**
+ * @brief Compute XXH64 of the data
+ *
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+ * @param[in] seed Seed
+ * @return XXH64 of the data
+ */
+uint64_t b64_xxh64(const void* data, const size_t size, const uint64_t seed);
+
+/**
+ * @brief Encode byte array Base64 encoding into the buffer, computing the checksums of the input
+ *
+ * The input is encoded by chunks, and the checksums are updated while each chunk is on the cache.
+ *
+ * @param[out] length Length of the encoded string
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_encoded_size()
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @param[in] digest_types Checksums to be computed, combination of B64_DIGEST_***
+ * @param[out] digest Checksums of the input byte array
+ * @return Result of the encoding, the null-terminated encoded string is written in dest on B64_SUCCESS
+ */
+B64Result b64_encode_into_with_digest(size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, const unsigned int digest_types, B64Digest* digest);
+
+/**
+ * @brief Decode Base64-encoded string into the buffer, computing the checksums of the output
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size()
+ * @param[in] src Pointer to the input null-terminated Base64-encoded string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[in] digest_types Checksums to be computed, combination of B64_DIGEST_***
+ * @param[out] digest Checksums of the decoded byte array
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_decode_into_with_digest(size_t* size, void* dest, const size_t dest_size, const char* src, const B64Alphabet* alphabet, const bool validate, const unsigned int digest_types, B64Digest* digest);
+
+/**
+ * @brief Decode Base64-encoded string with the length into the buffer, computing the checksums of the output
+ *
+ * The input is decoded by chunks, and the checksums are updated while the decoded bytes are on the cache.
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size_n()
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @param[in] digest_types Checksums to be computed, combination of B64_DIGEST_***
+ * @param[out] digest Checksums of the decoded byte array
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_decode_into_with_digest_n(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const unsigned int digest_types, B64Digest* digest);
+
 /**
  * @brief Decode standard Base64-encoded string
  *
@@ -78,6 +832,17 @@ void* b64_decode(size_t* size, const char* src, char last_2_encoding_chars[2], c
  */
 void* b64_std_decode(size_t* size, const char* src);
 
+/**
+ * @brief Decode standard Base64-encoded string with the length
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @return Pointer to the decoded byte array, dynamically allocated on the heap
+ * @retval NULL Decoding failed
+ */
+void* b64_std_decode_n(size_t* size, const char* src, const size_t src_length);
+
 /**
  * @brief Decode URL-safe Base64-encoded string
  *
@@ -88,6 +853,17 @@ void* b64_std_decode(size_t* size, const char* src);
  */
 void* b64_url_decode(size_t* size, const char* src);
 
+/**
+ * @brief Decode URL-safe Base64-encoded string with the length
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input URL-safe Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @return Pointer to the decoded byte array, dynamically allocated on the heap
+ * @retval NULL Decoding failed
+ */
+void* b64_url_decode_n(size_t* size, const char* src, const size_t src_length);
+
 /**
  * @brief Decode Base64-encoded string for MIME
  *
@@ -98,4 +874,221 @@ void* b64_url_decode(size_t* size, const char* src);
  */
 void* b64_mime_decode(size_t* size, const char* src);
 
+/**
+ * @brief Decode Base64-encoded string for MIME with the length
+ *
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[in] src Pointer to the input Base64-MIME-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @return Pointer to the decoded byte array, dynamically allocated on the heap
+ * @retval NULL Decoding failed
+ */
+void* b64_mime_decode_n(size_t* size, const char* src, const size_t src_length);
+
+/**
+ * @brief Input of the batch encoding/decoding
+ */
+typedef struct B64Span_tag {
+    const void* data; // Pointer to the input byte array (or the Base64-encoded string)
+    size_t size; // Byte size of the input (or length of the string)
+} B64Span;
+
+/**
+ * @brief Get the byte size of the buffer required for the batch encoding
+ *
+ * @param[in] srcs Array of the inputs
+ * @param[in] num_srcs The number of the inputs
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @return Total length of the encoded strings, without null characters
+ */
+size_t b64_get_batch_encoded_size(const B64Span* srcs, const size_t num_srcs, const bool use_padding, const size_t line_length);
+
+/**
+ * @brief Encode the byte arrays Base64 encoding into a contiguous buffer
+ *
+ * The i-th encoded string is written at dest[offsets[i]] to dest[offsets[i + 1] - 1] without a null character.
+ * An empty input is encoded to an empty string.
+ *
+ * @param[out] offsets Array of the offsets of the encoded strings, (num_srcs + 1) elements
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_batch_encoded_size()
+ * @param[in] srcs Array of the input byte arrays
+ * @param[in] num_srcs The number of the inputs
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @return Result of the encoding
+ */
+B64Result b64_encode_batch(size_t* offsets, char* dest, const size_t dest_size, const B64Span* srcs, const size_t num_srcs, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length);
+
+/**
+ * @brief Get the byte size of the buffer enough for the batch decoding
+ *
+ * @param[in] srcs Array of the input Base64-encoded strings
+ * @param[in] num_srcs The number of the inputs
+ * @return Upper bound of the total byte size of the decoded byte arrays
+ */
+size_t b64_get_batch_decoded_size(const B64Span* srcs, const size_t num_srcs);
+
+/**
+ * @brief Decode the Base64-encoded strings into a contiguous buffer
+ *
+ * The i-th decoded byte array is written at dest[offsets[i]] to dest[offsets[i + 1] - 1].
+ * An empty input (size 0) is decoded to an empty byte array, while an input of only padding or linebreaks fails.
+ * On failure, offsets are written up to the failed input.
+ *
+ * @param[out] offsets Array of the offsets of the decoded byte arrays, (num_srcs + 1) elements
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, b64_get_batch_decoded_size() is enough
+ * @param[in] srcs Array of the input Base64-encoded strings, not required to be null-terminated
+ * @param[in] num_srcs The number of the inputs
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input strings
+ * @return Result of the decoding
+ */
+B64Result b64_decode_batch(size_t* offsets, void* dest, const size_t dest_size, const B64Span* srcs, const size_t num_srcs, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief Thread pool for parallel Base64 encoding/decoding
+ */
+typedef struct B64ThreadPool_tag B64ThreadPool;
+
+/**
+ * @brief Create a thread pool
+ *
+ * The thread calling the parallel functions also works as one of the threads.
+ *
+ * @param[in] num_threads The number of the threads including the calling thread (the number of the processors with 0)
+ * @return Pointer to the thread pool, dynamically allocated on the heap
+ * @retval NULL Creation failed
+ */
+B64ThreadPool* b64_thread_pool_create(const size_t num_threads);
+
+/**
+ * @brief Destroy the thread pool
+ *
+ * @param[in,out] pool Thread pool, nothing is done with NULL
+ */
+void b64_thread_pool_destroy(B64ThreadPool* pool);
+
+/**
+ * @brief Get the number of the threads of the thread pool
+ *
+ * @param[in] pool Thread pool
+ * @return The number of the threads including the calling thread (1 with NULL)
+ */
+size_t b64_thread_pool_get_num_threads(const B64ThreadPool* pool);
+
+/**
+ * @brief Encode byte array Base64 encoding into the buffer in parallel
+ *
+ * The input is split at the multiples of 4 lines (or 3-byte blocks without linebreaks),
+ * then each chunk is encoded directly into its offset in the output buffer.
+ * The output is identical to b64_encode_into().
+ *
+ * @param[in,out] pool Thread pool, encoded in the calling thread with NULL
+ * @param[out] length Length of the encoded string
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_encoded_size()
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet used for the encoding
+ * @param[in] use_padding Use padding ('=')
+ * @param[in] line_length Length to insert linebreak (CRLF) (no linebreaks with 0)
+ * @return Result of the encoding, the null-terminated encoded string is written in dest on B64_SUCCESS
+ */
+B64Result b64_parallel_encode_into(B64ThreadPool* pool, size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length);
+
+/**
+ * @brief Decode Base64-encoded string with the length into the buffer in parallel
+ *
+ * The encoding characters are counted in parallel to split the input at 4-character blocks,
+ * then each chunk is decoded directly into its offset in the output buffer.
+ * The output is identical to b64_decode_into_n().
+ *
+ * @param[in,out] pool Thread pool, decoded in the calling thread with NULL
+ * @param[out] size Byte size of the output decoded byte array
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] dest_size Byte size of the output buffer, at least b64_get_decoded_size_n()
+ * @param[in] src Pointer to the input Base64-encoded string, not required to be null-terminated
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet used for the decoding
+ * @param[in] validate Validate characters in the input string
+ * @return Result of the decoding, the decoded byte array is written in dest on B64_SUCCESS
+ */
+B64Result b64_parallel_decode_into(B64ThreadPool* pool, size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate);
+
+/**
+ * @brief The number of the results (B64Result)
+ */
+#define B64_NUM_RESULTS (B64_ERROR_NON_ZERO_TRAILING_BITS + 1)
+
+/**
+ * @brief The number of the buckets of the latency histogram
+ */
+#define B64_STATS_NUM_LATENCY_BUCKETS 32
+
+/**
+ * @brief Entry points recorded in the statistics
+ */
+typedef enum B64StatsEntry_tag {
+    B64_STATS_ENCODE, // b64_encode(), b64_encode_with_alphabet(), b64_encode_with_allocator()
+    B64_STATS_STD_ENCODE, // b64_std_encode()
+    B64_STATS_URL_ENCODE, // b64_url_encode()
+    B64_STATS_MIME_ENCODE, // b64_mime_encode()
+    B64_STATS_DECODE, // b64_decode(_n)(), b64_decode_with_alphabet(_n)(), b64_decode_with_allocator(_n)(), b64_decode_with_error(_n)(), b64_decode_with_allocator_and_error(_n)(), b64_decode_strict(_with_allocator)(_n)()
+    B64_STATS_STD_DECODE, // b64_std_decode(_n)()
+    B64_STATS_URL_DECODE, // b64_url_decode(_n)()
+    B64_STATS_MIME_DECODE, // b64_mime_decode(_n)()
+    B64_STATS_NUM_ENTRIES
+} B64StatsEntry;
+
+/**
+ * @brief Statistics of an entry point
+ */
+typedef struct B64EntryStats_tag {
+    uint64_t num_calls; // The number of the calls
+    uint64_t input_size; // Total byte size (length) of the inputs
+    uint64_t output_size; // Total byte size (length) of the outputs of the succeeded calls
+    uint64_t num_results[B64_NUM_RESULTS]; // The number of the calls by the result, indexed by B64Result
+    uint64_t latency_histogram[B64_STATS_NUM_LATENCY_BUCKETS]; // The number of the calls by the latency, [i] for [2^i, 2^(i+1)) ns ([0] includes 0 ns)
+} B64EntryStats;
+
+/**
+ * @brief Statistics of all entry points
+ */
+typedef struct B64Stats_tag {
+    B64EntryStats entries[B64_STATS_NUM_ENTRIES]; // Statistics indexed by B64StatsEntry
+} B64Stats;
+
+/**
+ * @brief Get the statistics of all threads since the last reset
+ *
+ * The statistics are recorded only if the library is built with B64_STATS (make STATS=yes).
+ * Each thread records into its own counters without atomic operations or locks,
+ * which are summed up here (counters of exited threads are kept).
+ *
+ * @param[out] stats Statistics, all 0 if not recorded
+ * @return true if the statistics are recorded
+ */
+bool b64_stats_snapshot(B64Stats* stats);
+
+/**
+ * @brief Reset the statistics of all threads
+ */
+void b64_stats_reset(void);
+
+/**
+ * @brief Get the name of the entry point, e.g. for exporting the statistics
+ *
+ * @param[in] entry Entry point
+ * @return Name of the entry point (e.g. "b64_std_encode")
+ */
+const char* b64_stats_entry_name(const B64StatsEntry entry);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // B64_H
@@ -0,0 +1,504 @@
+/**
+ * @file b64.hpp
+ * @brief Header-only C++17 wrapper of Base64 encoding/decoding
+ *
+ * The output is appended directly into a caller's container (e.g. std::string, std::vector<std::byte>),
+ * which is resized once and written in place without an intermediate buffer.
+ * Literals are encoded/decoded at compile time into std::array constants by constexpr functions.
+ */
+#ifndef B64_HPP
+#define B64_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if (__cplusplus >= 202002L) && __has_include(<span>)
+#include <span>
+#define B64_HAS_SPAN
+#endif
+
+#if defined(__cpp_nontype_template_args) && (__cpp_nontype_template_args >= 201911L) && defined(__cpp_consteval)
+#define B64_HAS_LITERAL_OPERATOR
+#endif
+
+#include "b64.h"
+
+namespace b64 {
+
+/**
+ * @brief Options of the encoding
+ */
+struct EncodeOptions {
+    const B64Alphabet* alphabet = &b64_std_alphabet; // Alphabet used for the encoding
+    bool use_padding = true; // Use padding ('=')
+    std::size_t line_length = 0; // Length to insert linebreak (CRLF) (no linebreaks with 0)
+};
+
+/**
+ * @brief Options of the decoding
+ */
+struct DecodeOptions {
+    const B64Alphabet* alphabet = &b64_std_alphabet; // Alphabet used for the decoding
+    bool validate = true; // Validate characters in the input string
+};
+
+/** Standard encoding with padding */
+inline constexpr EncodeOptions std_encoding{ &b64_std_alphabet, true, 0 };
+
+/** URL-safe encoding without padding */
+inline constexpr EncodeOptions url_encoding{ &b64_url_alphabet, false, 0 };
+
+/** MIME encoding with linebreaks every 76 characters */
+inline constexpr EncodeOptions mime_encoding{ &b64_std_alphabet, true, B64_MIME_LINE_LENGTH };
+
+/** Standard decoding with validation */
+inline constexpr DecodeOptions std_decoding{ &b64_std_alphabet, true };
+
+/** URL-safe decoding with validation */
+inline constexpr DecodeOptions url_decoding{ &b64_url_alphabet, true };
+
+/** MIME decoding skipping non encoding characters */
+inline constexpr DecodeOptions mime_decoding{ &b64_std_alphabet, false };
+
+/** 62nd/63rd encoding characters of the standard encoding, for the compile-time encoding/decoding */
+inline constexpr char std_encoding_chars[2] = { '+', '/' };
+
+/** 62nd/63rd encoding characters of the URL-safe encoding, for the compile-time encoding/decoding */
+inline constexpr char url_encoding_chars[2] = { '-', '_' };
+
+namespace detail {
+
+/**
+ * @brief Check the container holds 1-byte elements contiguously (e.g. std::string, std::vector<std::byte>)
+ */
+template <class Container>
+inline constexpr bool is_byte_container_v = (sizeof(typename Container::value_type) == 1) &&
+    std::is_trivially_copyable_v<typename Container::value_type>;
+
+/**
+ * @brief Check the container is std::basic_string
+ */
+template <class Container>
+struct is_basic_string : std::false_type {};
+
+template <class CharT, class Traits, class Allocator>
+struct is_basic_string<std::basic_string<CharT, Traits, Allocator>> : std::true_type {};
+
+/**
+ * @brief Append the output of the writer at the end of the container
+ *
+ * The container is resized once to the upper bound, written in place, then shrunk to the written size.
+ * The container is restored to the original size on failure.
+ *
+ * @param[in,out] out Container
+ * @param[in] max_size Upper bound of the byte size of the output
+ * @param[in] write Writer called with (pointer, max_size, written_size&), returning B64Result
+ * @return Result of the writer
+ */
+template <class Container, class Writer>
+B64Result append_in_place(Container& out, const std::size_t max_size, Writer&& write) {
+    static_assert(is_byte_container_v<Container>, "elements of the container must be 1 byte");
+
+    const std::size_t offset = out.size();
+    B64Result result = B64_SUCCESS;
+
+#ifdef __cpp_lib_string_resize_and_overwrite
+    if constexpr (is_basic_string<Container>::value) {
+        // The added elements are not initialized before being written
+        out.resize_and_overwrite(offset + max_size, [&](typename Container::value_type* data, std::size_t) {
+            std::size_t written_size = 0;
+            result = write(&data[offset], max_size, written_size);
+            return offset + ((result == B64_SUCCESS) ? written_size : 0);
+        });
+        return result;
+    }
+#endif
+
+    out.resize(offset + max_size);
+    std::size_t written_size = 0;
+    result = write(&out.data()[offset], max_size, written_size);
+    out.resize(offset + ((result == B64_SUCCESS) ? written_size : 0));
+
+    return result;
+}
+
+/**
+ * @brief Get the upper bound of the decoded byte size from the input length
+ *
+ * @param[in] src_length Length of the input string
+ * @return Upper bound of the byte size of the decoded bytes
+ */
+constexpr std::size_t get_max_decoded_size(const std::size_t src_length) {
+    return (src_length / 4 * 3) + ((src_length % 4) * 3 / 4);
+}
+
+/**
+ * @brief Get the encoded length (without a null character) from the byte size
+ *
+ * @param[in] src_size Byte size of the input
+ * @param[in] use_padding Use padding ('=')
+ * @return Length of the encoded string
+ */
+constexpr std::size_t get_encoded_length(const std::size_t src_size, const bool use_padding) {
+    return use_padding ? ((src_size + 2) / 3 * 4) : ((src_size * 4 + 2) / 3);
+}
+
+/**
+ * @brief Encode a 6-bit value into a character
+ *
+ * @param[in] value 6-bit value
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return Encoding character
+ */
+constexpr char encode_value(const std::uint8_t value, const char (&chars)[2]) {
+    return (value < 26) ? static_cast<char>('A' + value) :
+        (value < 52) ? static_cast<char>('a' + (value - 26)) :
+        (value < 62) ? static_cast<char>('0' + (value - 52)) :
+        chars[value - 62];
+}
+
+/**
+ * @brief Decode a character into a 6-bit value
+ *
+ * @param[in] c Character
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return 6-bit value
+ * @retval -1 if the character is not an encoding character
+ */
+constexpr int decode_char(const char c, const char (&chars)[2]) {
+    return ((c >= 'A') && (c <= 'Z')) ? (c - 'A') :
+        ((c >= 'a') && (c <= 'z')) ? (c - 'a' + 26) :
+        ((c >= '0') && (c <= '9')) ? (c - '0' + 52) :
+        (c == chars[0]) ? 62 :
+        (c == chars[1]) ? 63 :
+        -1;
+}
+
+/**
+ * @brief Reject an invalid literal
+ *
+ * Not constexpr, so a call in a constant evaluation fails the compilation.
+ * The program is aborted if it is called at runtime.
+ */
+[[noreturn]] inline void invalid_literal(void) {
+    std::abort();
+}
+
+/**
+ * @brief Encode the byte array at compile time
+ *
+ * @param[in] src Input byte array (string literal or std::array)
+ * @param[in] src_size Byte size of the input
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return Encoded characters
+ */
+template <std::size_t Length, bool UsePadding, class Bytes>
+constexpr std::array<char, Length> encode_bytes(const Bytes& src, const std::size_t src_size, const char (&chars)[2]) {
+    std::array<char, Length> dest{};
+
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < src_size; i += 3) {
+        const std::size_t remain = src_size - i;
+        const std::uint32_t bytes =
+            (static_cast<std::uint32_t>(static_cast<std::uint8_t>(src[i])) << 16) |
+            ((remain > 1) ? (static_cast<std::uint32_t>(static_cast<std::uint8_t>(src[i + 1])) << 8) : 0) |
+            ((remain > 2) ? static_cast<std::uint32_t>(static_cast<std::uint8_t>(src[i + 2])) : 0);
+
+        const std::size_t num_chars = (remain > 2) ? 4 : (remain + 1);
+        for (std::size_t k = 0; k < num_chars; ++k) {
+            dest[j++] = encode_value(static_cast<std::uint8_t>((bytes >> (18 - k * 6)) & 0x3f), chars);
+        }
+        if constexpr (UsePadding) {
+            for (std::size_t k = num_chars; k < 4; ++k) {
+                dest[j++] = '=';
+            }
+        }
+    }
+
+    return dest;
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the decoded byte size of the Base64-encoded literal at compile time
+ *
+ * @param[in] src Base64-encoded string literal, padding is optional
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return Byte size of the decoded bytes, the compilation fails for an invalid literal
+ */
+template <std::size_t N>
+constexpr std::size_t get_decoded_size(const char (&src)[N], const char (&chars)[2] = std_encoding_chars) {
+    std::size_t length = N - 1;
+    const std::size_t num_paddings = ((length > 0) && (src[length - 1] == '=')) ? (((length > 1) && (src[length - 2] == '=')) ? 2 : 1) : 0;
+    if ((length == 0) || ((num_paddings > 0) && ((length % 4) != 0))) {
+        detail::invalid_literal();
+    }
+    length -= num_paddings;
+    if ((length % 4) == 1) {
+        detail::invalid_literal();
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+        if (detail::decode_char(src[i], chars) < 0) {
+            detail::invalid_literal();
+        }
+    }
+
+    return length / 4 * 3 + (length % 4) * 3 / 4;
+}
+
+/**
+ * @brief Encode the string literal (without a null character) at compile time
+ *
+ * @param[in] src Input string literal
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return Encoded characters, not null-terminated
+ */
+template <bool UsePadding = true, std::size_t N>
+constexpr std::array<char, detail::get_encoded_length(N - 1, UsePadding)> encode_array(const char (&src)[N], const char (&chars)[2] = std_encoding_chars) {
+    return detail::encode_bytes<detail::get_encoded_length(N - 1, UsePadding), UsePadding>(src, N - 1, chars);
+}
+
+/**
+ * @brief Encode the byte array at compile time
+ *
+ * @param[in] src Input byte array
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return Encoded characters, not null-terminated
+ */
+template <bool UsePadding = true, std::size_t N>
+constexpr std::array<char, detail::get_encoded_length(N, UsePadding)> encode_array(const std::array<std::uint8_t, N>& src, const char (&chars)[2] = std_encoding_chars) {
+    return detail::encode_bytes<detail::get_encoded_length(N, UsePadding), UsePadding>(src, N, chars);
+}
+
+/**
+ * @brief Decode the Base64-encoded literal at compile time
+ *
+ * The decoded size is given by get_decoded_size() with the same literal,
+ * or the literal operators in b64::literals can be used with C++20.
+ *
+ * @param[in] src Base64-encoded string literal, padding is optional
+ * @param[in] chars 62nd/63rd encoding characters
+ * @return Decoded byte array, the compilation fails for an invalid literal or the wrong Size
+ */
+template <std::size_t Size, std::size_t N>
+constexpr std::array<std::uint8_t, Size> decode_array(const char (&src)[N], const char (&chars)[2] = std_encoding_chars) {
+    if (get_decoded_size(src, chars) != Size) {
+        detail::invalid_literal();
+    }
+
+    std::array<std::uint8_t, Size> dest{};
+
+    std::uint32_t bits = 0;
+    std::size_t num_bits = 0;
+    std::size_t j = 0;
+    for (std::size_t i = 0; j < Size; ++i) {
+        bits = (bits << 6) | static_cast<std::uint32_t>(detail::decode_char(src[i], chars));
+        num_bits += 6;
+        if (num_bits >= 8) {
+            num_bits -= 8;
+            dest[j++] = static_cast<std::uint8_t>(bits >> num_bits);
+            bits &= (1u << num_bits) - 1;
+        }
+    }
+
+    return dest;
+}
+
+#ifdef B64_HAS_LITERAL_OPERATOR
+namespace detail {
+
+/**
+ * @brief String literal passed as a template argument of the literal operators
+ */
+template <std::size_t N>
+struct Literal {
+    char chars[N]{};
+
+    consteval Literal(const char (&src)[N]) {
+        for (std::size_t i = 0; i < N; ++i) {
+            chars[i] = src[i];
+        }
+    }
+};
+
+} // namespace detail
+
+namespace literals {
+
+/**
+ * @brief Decode the standard Base64-encoded literal at compile time, e.g. "QUJD"_b64
+ *
+ * @return Decoded byte array (std::array<std::uint8_t, decoded size>)
+ */
+template <detail::Literal L>
+consteval auto operator""_b64() {
+    return decode_array<get_decoded_size(L.chars)>(L.chars);
+}
+
+/**
+ * @brief Decode the URL-safe Base64-encoded literal at compile time, e.g. "89-_"_b64url
+ *
+ * @return Decoded byte array (std::array<std::uint8_t, decoded size>)
+ */
+template <detail::Literal L>
+consteval auto operator""_b64url() {
+    return decode_array<get_decoded_size(L.chars, url_encoding_chars)>(L.chars, url_encoding_chars);
+}
+
+} // namespace literals
+#endif
+
+/**
+ * @brief Encode the byte array and append the encoded string to the container
+ *
+ * @param[in,out] out Container of characters (e.g. std::string), the encoded string is appended without a null character
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] options Options of the encoding
+ * @return Result of the encoding, out is unchanged on failure
+ */
+template <class Container>
+B64Result encode_append(Container& out, const void* src, const std::size_t src_size, const EncodeOptions& options = std_encoding) {
+    // Including a null character, which is dropped after the encoding
+    const std::size_t encoded_size = b64_get_encoded_size(src_size, options.use_padding, options.line_length);
+    if (encoded_size == 0) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+
+    return detail::append_in_place(out, encoded_size, [&](auto* dest, const std::size_t dest_size, std::size_t& length) {
+        return b64_encode_into(&length, reinterpret_cast<char*>(dest), dest_size, src, src_size, options.alphabet, options.use_padding, options.line_length);
+    });
+}
+
+/**
+ * @brief Encode the bytes of the string and append the encoded string to the container
+ *
+ * @param[in,out] out Container of characters (e.g. std::string), the encoded string is appended without a null character
+ * @param[in] src Input bytes
+ * @param[in] options Options of the encoding
+ * @return Result of the encoding, out is unchanged on failure
+ */
+template <class Container>
+B64Result encode_append(Container& out, const std::string_view src, const EncodeOptions& options = std_encoding) {
+    return encode_append(out, src.data(), src.size(), options);
+}
+
+#ifdef B64_HAS_SPAN
+/**
+ * @brief Encode the byte array and append the encoded string to the container
+ *
+ * @param[in,out] out Container of characters (e.g. std::string), the encoded string is appended without a null character
+ * @param[in] src Input byte array
+ * @param[in] options Options of the encoding
+ * @return Result of the encoding, out is unchanged on failure
+ */
+template <class Container>
+B64Result encode_append(Container& out, const std::span<const std::byte> src, const EncodeOptions& options = std_encoding) {
+    return encode_append(out, src.data(), src.size(), options);
+}
+#endif
+
+/**
+ * @brief Decode the Base64-encoded string and append the decoded byte array to the container
+ *
+ * @param[in,out] out Container of bytes (e.g. std::vector<std::byte>, std::string)
+ * @param[in] src Input Base64-encoded string, not required to be null-terminated
+ * @param[in] options Options of the decoding
+ * @return Result of the decoding, out is unchanged on failure
+ */
+template <class Container>
+B64Result decode_append(Container& out, const std::string_view src, const DecodeOptions& options = std_decoding) {
+    // Also for a default-constructed view, whose data() is null
+    if (src.empty()) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+
+    const std::size_t max_size = detail::get_max_decoded_size(src.size());
+    if (max_size == 0) {
+        // Decoded only to get the error
+        std::size_t size;
+        unsigned char empty_buf[1];
+        return b64_decode_into_n(&size, empty_buf, 0, src.data(), src.size(), options.alphabet, options.validate);
+    }
+
+    return detail::append_in_place(out, max_size, [&](auto* dest, const std::size_t dest_size, std::size_t& size) {
+        return b64_decode_into_n(&size, dest, dest_size, src.data(), src.size(), options.alphabet, options.validate);
+    });
+}
+
+/**
+ * @brief Encode the byte array into a new container
+ *
+ * @param[in] src Pointer to the input byte array
+ * @param[in] src_size Byte size of the input
+ * @param[in] options Options of the encoding
+ * @return Container of the encoded string, moved out
+ * @retval std::nullopt if the encoding failed
+ */
+template <class Container = std::string>
+std::optional<Container> encode(const void* src, const std::size_t src_size, const EncodeOptions& options = std_encoding) {
+    Container out;
+    if (encode_append(out, src, src_size, options) != B64_SUCCESS) {
+        return std::nullopt;
+    }
+
+    return std::optional<Container>(std::move(out));
+}
+
+/**
+ * @brief Encode the bytes of the string into a new container
+ *
+ * @param[in] src Input bytes
+ * @param[in] options Options of the encoding
+ * @return Container of the encoded string, moved out
+ * @retval std::nullopt if the encoding failed
+ */
+template <class Container = std::string>
+std::optional<Container> encode(const std::string_view src, const EncodeOptions& options = std_encoding) {
+    return encode<Container>(src.data(), src.size(), options);
+}
+
+#ifdef B64_HAS_SPAN
+/**
+ * @brief Encode the byte array into a new container
+ *
+ * @param[in] src Input byte array
+ * @param[in] options Options of the encoding
+ * @return Container of the encoded string, moved out
+ * @retval std::nullopt if the encoding failed
+ */
+template <class Container = std::string>
+std::optional<Container> encode(const std::span<const std::byte> src, const EncodeOptions& options = std_encoding) {
+    return encode<Container>(src.data(), src.size(), options);
+}
+#endif
+
+/**
+ * @brief Decode the Base64-encoded string into a new container
+ *
+ * @param[in] src Input Base64-encoded string, not required to be null-terminated
+ * @param[in] options Options of the decoding
+ * @return Container of the decoded byte array (e.g. std::vector<std::byte>), moved out
+ * @retval std::nullopt if the decoding failed
+ */
+template <class Container>
+std::optional<Container> decode(const std::string_view src, const DecodeOptions& options = std_decoding) {
+    Container out;
+    if (decode_append(out, src, options) != B64_SUCCESS) {
+        return std::nullopt;
+    }
+
+    return std::optional<Container>(std::move(out));
+}
+
+} // namespace b64
+
+#endif // B64_HPP
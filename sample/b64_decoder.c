@@ -5,53 +5,32 @@
 
 #include "b64.h"
 
-// Get the byte size of the file
-long get_file_size(const char* file) {
-    FILE* fp = fopen(file, "rb");
-    if (fp == NULL) {
-        fprintf(stderr, "Error: failed to open %s\n", file);
-        return -1;
-    }
-
-    if (fseek(fp, 0L, SEEK_END) == 0) {
-        long fsize = ftell(fp);
-        if (fsize != -1) {
-            fclose(fp);
-            return fsize;
-        }
-    }
+// Length of the input chunk read at once
+#define CHUNK_LENGTH (64 * 1024)
 
-    fclose(fp);
+// Decoded chunk, including the characters kept from the previous chunk
+#define DECODED_CHUNK_SIZE ((CHUNK_LENGTH + 3) / 4 * 3)
 
-    return -1;
-}
-
-char* input_chars = NULL;
-uint8_t* decoded_bytes = NULL;
-
-// Free dynamically allocated memories
-void free_memories(void) {
-    free(input_chars);
-    free(decoded_bytes);
-}
+FILE* input_fp = NULL;
+FILE* output_fp = NULL;
 
-// Write base64 decoded bytes to a file
-bool write_decoded_bytes_to_file(const uint8_t* decoded_bytes, const size_t size, const char* fname) {
-    FILE* fp = fopen(fname,"wb");
-    if (fp == NULL) {
-        fprintf(stderr, "Error: failed to open %s\n", fname);
-        return false;
+// Close opened files
+void close_files(void) {
+    if (input_fp != NULL) {
+        fclose(input_fp);
     }
+    if (output_fp != NULL) {
+        fclose(output_fp);
+    }
+}
 
-    fwrite(decoded_bytes, sizeof(uint8_t), size, fp);
-
-    fclose(fp);
-
-    return true;
+// Write base64 decoded bytes to the file
+bool write_decoded_bytes_to_file(const uint8_t* decoded_bytes, const size_t size, FILE* fp) {
+    return fwrite(decoded_bytes, sizeof(uint8_t), size, fp) == size;
 }
 
 int main(int argc, char* argv[]) {
-    atexit(free_memories);
+    atexit(close_files);
 
     if (argc < 2) {
         fprintf(stderr, "Error: input file is not specified\n");
@@ -65,44 +44,61 @@ int main(int argc, char* argv[]) {
         out_fname = argv[2];
     }
 
-    long fsize = get_file_size(fname);
-    if (fsize == -1) {
-        fprintf(stderr, "Error: failed to get file size of %s\n", fname);
-        exit(EXIT_FAILURE);
-    }
-
-    FILE* fp = fopen(fname, "rb");
-    if (fp == NULL) {
+    input_fp = fopen(fname, "rb");
+    if (input_fp == NULL) {
         fprintf(stderr, "Error: failed to open %s\n", fname);
         exit(EXIT_FAILURE);
     }
 
-    input_chars = malloc(sizeof(char) * ((size_t)fsize + 1)); // Consider NULL character
-    if (input_chars == NULL) {
-        fprintf(stderr, "Error: failed to allocate memory\n");
+    output_fp = fopen(out_fname, "wb");
+    if (output_fp == NULL) {
+        fprintf(stderr, "Error: failed to open %s\n", out_fname);
         exit(EXIT_FAILURE);
     }
 
-    size_t read_size = fread(input_chars, sizeof(char), (size_t)fsize, fp);
-    if (read_size != (size_t)fsize) {
-        fprintf(stderr, "Error: failed to read %s\n", fname);
-        exit(EXIT_FAILURE);
-    }
+    // Decode the file by chunks not to read the whole file on memory
+    static char input_chars[CHUNK_LENGTH];
+    static uint8_t decoded_bytes[DECODED_CHUNK_SIZE];
 
-    fclose(fp);
+    B64DecodeState state;
+    b64_decode_init(&state, &b64_std_alphabet, true);
 
-    size_t decoded_size;
-    uint8_t* decoded_bytes = b64_std_decode(&decoded_size, input_chars);
+    size_t read_length = 0;
+    size_t total_size = 0;
+    size_t size;
 
-    printf("Base64 decoding of %s is finished (%lu to %lu bytes).\n", fname, read_size, decoded_size);
+    size_t length;
+    while ((length = fread(input_chars, sizeof(char), CHUNK_LENGTH, input_fp)) > 0) {
+        read_length += length;
 
-    if (!write_decoded_bytes_to_file(decoded_bytes, (size_t)decoded_size, out_fname)) {
+        if (b64_decode_update(&state, &size, decoded_bytes, sizeof(decoded_bytes), input_chars, length) != B64_SUCCESS) {
+            fprintf(stderr, "Error: failed to decode %s\n", fname);
+            exit(EXIT_FAILURE);
+        }
+        if (!write_decoded_bytes_to_file(decoded_bytes, size, output_fp)) {
+            fprintf(stderr, "Error: failed to write %s\n", out_fname);
+            exit(EXIT_FAILURE);
+        }
+        total_size += size;
+    }
+    if (ferror(input_fp)) {
+        fprintf(stderr, "Error: failed to read %s\n", fname);
         exit(EXIT_FAILURE);
     }
 
-    printf("The byte expression is written to '%s'.\n", out_fname);
+    if (b64_decode_final(&state, &size, decoded_bytes, sizeof(decoded_bytes)) != B64_SUCCESS) {
+        fprintf(stderr, "Error: failed to decode %s\n", fname);
+        exit(EXIT_FAILURE);
+    }
+    if (!write_decoded_bytes_to_file(decoded_bytes, size, output_fp)) {
+        fprintf(stderr, "Error: failed to write %s\n", out_fname);
+        exit(EXIT_FAILURE);
+    }
+    total_size += size;
+
+    printf("Base64 decoding of %s is finished (%lu to %lu bytes).\n", fname, read_length, total_size);
 
-    free(decoded_bytes);
+    printf("The byte expression is written to '%s'.\n", out_fname);
 
     return EXIT_SUCCESS;
 }
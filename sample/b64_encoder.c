@@ -5,57 +5,32 @@
 
 #include "b64.h"
 
-// Get the byte size of the file
-long get_file_size(const char* file) {
-    FILE* fp = fopen(file, "rb");
-    if (fp == NULL) {
-        fprintf(stderr, "Error: failed to open %s\n", file);
-        return -1;
-    }
-
-    if (fseek(fp, 0L, SEEK_END) == 0) {
-        long fsize = ftell(fp);
-        if (fsize != -1) {
-            fclose(fp);
-            return fsize;
-        }
-    }
-
-    fclose(fp);
-
-    return -1;
-}
+// Byte size of the input chunk read at once
+#define CHUNK_SIZE (64 * 1024)
 
-uint8_t* input_bytes = NULL;
-char* encoded_str = NULL;
+// Encoded chunk, including CRLF and the final block
+#define ENCODED_CHUNK_SIZE (CHUNK_SIZE / 3 * 4 + 8)
 
-// Free dynamically allocated memories
-void free_memories(void) {
-    free(input_bytes);
-    free(encoded_str);
-}
+FILE* input_fp = NULL;
+FILE* output_fp = NULL;
 
-// Write base64 encoded string to a file
-bool write_b64_str_to_file(const char* encoded_str, const char* fname) {
-    FILE* fp = fopen(fname,"wb");
-    if (fp == NULL) {
-        fprintf(stderr, "Error: failed to open %s\n", fname);
-        return false;
+// Close opened files
+void close_files(void) {
+    if (input_fp != NULL) {
+        fclose(input_fp);
     }
-
-    size_t i = 0;
-    while (encoded_str[i] != '\0') {
-        fwrite(&encoded_str[i], sizeof(char), 1, fp);
-        ++i;
+    if (output_fp != NULL) {
+        fclose(output_fp);
     }
+}
 
-    fclose(fp);
-
-    return true;
+// Write base64 encoded string to the file
+bool write_b64_str_to_file(const char* encoded_str, const size_t length, FILE* fp) {
+    return fwrite(encoded_str, sizeof(char), length, fp) == length;
 }
 
 int main(int argc, char* argv[]) {
-    atexit(free_memories);
+    atexit(close_files);
 
     if (argc < 2) {
         fprintf(stderr, "Error: input file is not specified\n");
@@ -69,44 +44,58 @@ int main(int argc, char* argv[]) {
         out_fname = argv[2];
     }
 
-    long fsize = get_file_size(fname);
-    if (fsize == -1) {
-        fprintf(stderr, "Error: failed to get file size of %s\n", fname);
-        exit(EXIT_FAILURE);
-    }
-
-    FILE* fp = fopen(fname, "rb");
-    if (fp == NULL) {
+    input_fp = fopen(fname, "rb");
+    if (input_fp == NULL) {
         fprintf(stderr, "Error: failed to open %s\n", fname);
         exit(EXIT_FAILURE);
     }
 
-    input_bytes = malloc(sizeof(uint8_t) * (size_t)fsize);
-    if (input_bytes == NULL) {
-        fprintf(stderr, "Error: failed to allocate memory\n");
+    output_fp = fopen(out_fname, "wb");
+    if (output_fp == NULL) {
+        fprintf(stderr, "Error: failed to open %s\n", out_fname);
         exit(EXIT_FAILURE);
     }
 
-    size_t read_size = fread(input_bytes, sizeof(uint8_t), (size_t)fsize, fp);
-    if (read_size != (size_t)fsize) {
-        fprintf(stderr, "Error: failed to read %s\n", fname);
-        exit(EXIT_FAILURE);
-    }
+    // Encode the file by chunks not to read the whole file on memory
+    static uint8_t input_bytes[CHUNK_SIZE];
+    static char encoded_str[ENCODED_CHUNK_SIZE];
 
-    fclose(fp);
+    B64EncodeState state;
+    b64_encode_init(&state, &b64_std_alphabet, true, 0);
 
+    size_t read_size = 0;
+    size_t total_length = 0;
     size_t length;
-    char* encoded_str = b64_std_encode(&length, input_bytes, (size_t)fsize);
 
-    printf("Base64 encoding of %s is finished (%lu to %lu bytes).\n", fname, read_size, length);
+    size_t size;
+    while ((size = fread(input_bytes, sizeof(uint8_t), CHUNK_SIZE, input_fp)) > 0) {
+        read_size += size;
 
-    if (!write_b64_str_to_file(encoded_str, out_fname)) {
+        if (b64_encode_update(&state, &length, encoded_str, sizeof(encoded_str), input_bytes, size) != B64_SUCCESS) {
+            fprintf(stderr, "Error: failed to encode %s\n", fname);
+            exit(EXIT_FAILURE);
+        }
+        if (!write_b64_str_to_file(encoded_str, length, output_fp)) {
+            fprintf(stderr, "Error: failed to write %s\n", out_fname);
+            exit(EXIT_FAILURE);
+        }
+        total_length += length;
+    }
+    if (ferror(input_fp)) {
+        fprintf(stderr, "Error: failed to read %s\n", fname);
         exit(EXIT_FAILURE);
     }
 
-    printf("The string is written to '%s'.\n", out_fname);
+    if ((b64_encode_final(&state, &length, encoded_str, sizeof(encoded_str)) != B64_SUCCESS) ||
+        !write_b64_str_to_file(encoded_str, length, output_fp)) {
+        fprintf(stderr, "Error: failed to write %s\n", out_fname);
+        exit(EXIT_FAILURE);
+    }
+    total_length += length;
+
+    printf("Base64 encoding of %s is finished (%lu to %lu bytes).\n", fname, read_size, total_length);
 
-    free(encoded_str);
+    printf("The string is written to '%s'.\n", out_fname);
 
     return EXIT_SUCCESS;
 }
@@ -2,42 +2,255 @@
  * @file b64.h
  * @brief Base64 encoding/decoding
 */
-#include <ctype.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "b64.h"
+#include "b64_internal.h"
 
-/** Base64 encoding table with 6-bit index and encoded character */
-static char encoding_table[] = {
-    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
-    'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T',
-    'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd',
-    'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
-    'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x',
-    'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7',
-    '8', '9', '+', '/'
+/**
+ * @brief The number of 3-byte blocks encoded at once before wrapping in lines
+*/
+#define LINE_BUFFER_BLOCKS 768
+
+/**
+ * @brief Decode an encoding character to its 6-bit value (constant expression)
+*/
+#define DECODE_VALUE(c, c62, c63) ( \
+    (((c) >= 'A') && ((c) <= 'Z')) ? ((c) - 'A') : \
+    (((c) >= 'a') && ((c) <= 'z')) ? ((c) - 'a' + 26) : \
+    (((c) >= '0') && ((c) <= '9')) ? ((c) - '0' + 52) : \
+    ((c) == (c62)) ? 62 : \
+    ((c) == (c63)) ? 63 : INVALID_VALUE)
+
+#define DECODE_ROW4(c, c62, c63) \
+    DECODE_VALUE((c), c62, c63), DECODE_VALUE((c) + 1, c62, c63), \
+    DECODE_VALUE((c) + 2, c62, c63), DECODE_VALUE((c) + 3, c62, c63)
+#define DECODE_ROW16(c, c62, c63) \
+    DECODE_ROW4((c), c62, c63), DECODE_ROW4((c) + 4, c62, c63), \
+    DECODE_ROW4((c) + 8, c62, c63), DECODE_ROW4((c) + 12, c62, c63)
+#define DECODE_ROW64(c, c62, c63) \
+    DECODE_ROW16((c), c62, c63), DECODE_ROW16((c) + 16, c62, c63), \
+    DECODE_ROW16((c) + 32, c62, c63), DECODE_ROW16((c) + 48, c62, c63)
+
+/**
+ * @brief Initializer of a 256-entry decoding table, indexed by the input character
+*/
+#define DECODING_TABLE(c62, c63) { \
+    DECODE_ROW64(0, c62, c63), DECODE_ROW64(64, c62, c63), \
+    DECODE_ROW64(128, c62, c63), DECODE_ROW64(192, c62, c63) \
+}
+
+/**
+ * @brief Initializer of a Base64 encoding table with 6-bit index and encoded character
+*/
+#define ENCODING_TABLE(c62, c63) { \
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', \
+    'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', \
+    'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', \
+    'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', \
+    'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', \
+    'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', \
+    '8', '9', (c62), (c63) \
+}
+
+/**
+ * @brief Encode a 6-bit value to its encoding character (constant expression)
+*/
+#define ENCODE_CHAR(v, c62, c63) (char)( \
+    ((v) < 26) ? ('A' + (v)) : \
+    ((v) < 52) ? ('a' + (v) - 26) : \
+    ((v) < 62) ? ('0' + (v) - 52) : \
+    ((v) == 62) ? (c62) : (c63))
+
+#define ENCODE_PAIR(v, c62, c63) { ENCODE_CHAR((v) >> 6, c62, c63), ENCODE_CHAR((v) & 0x3f, c62, c63) }
+#define ENCODE_PAIR_ROW4(v, c62, c63) \
+    ENCODE_PAIR((v), c62, c63), ENCODE_PAIR((v) + 1, c62, c63), \
+    ENCODE_PAIR((v) + 2, c62, c63), ENCODE_PAIR((v) + 3, c62, c63)
+#define ENCODE_PAIR_ROW16(v, c62, c63) \
+    ENCODE_PAIR_ROW4((v), c62, c63), ENCODE_PAIR_ROW4((v) + 4, c62, c63), \
+    ENCODE_PAIR_ROW4((v) + 8, c62, c63), ENCODE_PAIR_ROW4((v) + 12, c62, c63)
+#define ENCODE_PAIR_ROW64(v, c62, c63) \
+    ENCODE_PAIR_ROW16((v), c62, c63), ENCODE_PAIR_ROW16((v) + 16, c62, c63), \
+    ENCODE_PAIR_ROW16((v) + 32, c62, c63), ENCODE_PAIR_ROW16((v) + 48, c62, c63)
+#define ENCODE_PAIR_ROW256(v, c62, c63) \
+    ENCODE_PAIR_ROW64((v), c62, c63), ENCODE_PAIR_ROW64((v) + 64, c62, c63), \
+    ENCODE_PAIR_ROW64((v) + 128, c62, c63), ENCODE_PAIR_ROW64((v) + 192, c62, c63)
+#define ENCODE_PAIR_ROW1024(v, c62, c63) \
+    ENCODE_PAIR_ROW256((v), c62, c63), ENCODE_PAIR_ROW256((v) + 256, c62, c63), \
+    ENCODE_PAIR_ROW256((v) + 512, c62, c63), ENCODE_PAIR_ROW256((v) + 768, c62, c63)
+
+/**
+ * @brief Initializer of a 4096-entry encoding table, indexed by 12-bit value
+*/
+#define ENCODING_PAIR_TABLE(c62, c63) { \
+    ENCODE_PAIR_ROW1024(0, c62, c63), ENCODE_PAIR_ROW1024(1024, c62, c63), \
+    ENCODE_PAIR_ROW1024(2048, c62, c63), ENCODE_PAIR_ROW1024(3072, c62, c63) \
+}
+
+/**
+ * @brief Decode an encoding character to its 6-bit value shifted in a 24-bit block (constant expression)
+*/
+#define SHIFTED_DECODE_VALUE(c, c62, c63, shift) \
+    ((DECODE_VALUE((c), c62, c63) == INVALID_VALUE) ? SHIFTED_INVALID_VALUE : ((uint32_t)DECODE_VALUE((c), c62, c63) << (shift)))
+
+#define SHIFTED_DECODE_ROW4(c, c62, c63, shift) \
+    SHIFTED_DECODE_VALUE((c), c62, c63, shift), SHIFTED_DECODE_VALUE((c) + 1, c62, c63, shift), \
+    SHIFTED_DECODE_VALUE((c) + 2, c62, c63, shift), SHIFTED_DECODE_VALUE((c) + 3, c62, c63, shift)
+#define SHIFTED_DECODE_ROW16(c, c62, c63, shift) \
+    SHIFTED_DECODE_ROW4((c), c62, c63, shift), SHIFTED_DECODE_ROW4((c) + 4, c62, c63, shift), \
+    SHIFTED_DECODE_ROW4((c) + 8, c62, c63, shift), SHIFTED_DECODE_ROW4((c) + 12, c62, c63, shift)
+#define SHIFTED_DECODE_ROW64(c, c62, c63, shift) \
+    SHIFTED_DECODE_ROW16((c), c62, c63, shift), SHIFTED_DECODE_ROW16((c) + 16, c62, c63, shift), \
+    SHIFTED_DECODE_ROW16((c) + 32, c62, c63, shift), SHIFTED_DECODE_ROW16((c) + 48, c62, c63, shift)
+#define SHIFTED_DECODING_TABLE(c62, c63, shift) { \
+    SHIFTED_DECODE_ROW64(0, c62, c63, shift), SHIFTED_DECODE_ROW64(64, c62, c63, shift), \
+    SHIFTED_DECODE_ROW64(128, c62, c63, shift), SHIFTED_DECODE_ROW64(192, c62, c63, shift) \
+}
+
+/**
+ * @brief Initializer of the decoding tables for each character position in a 4-character block
+*/
+#define SHIFTED_DECODING_TABLES(c62, c63) { \
+    SHIFTED_DECODING_TABLE(c62, c63, 18), SHIFTED_DECODING_TABLE(c62, c63, 12), \
+    SHIFTED_DECODING_TABLE(c62, c63, 6), SHIFTED_DECODING_TABLE(c62, c63, 0) \
+}
+
+const B64Alphabet b64_std_alphabet = {
+    ENCODING_TABLE('+', '/'),
+    DECODING_TABLE('+', '/'),
+    ENCODING_PAIR_TABLE('+', '/'),
+    SHIFTED_DECODING_TABLES('+', '/')
+};
+
+const B64Alphabet b64_url_alphabet = {
+    ENCODING_TABLE('-', '_'),
+    DECODING_TABLE('-', '_'),
+    ENCODING_PAIR_TABLE('-', '_'),
+    SHIFTED_DECODING_TABLES('-', '_')
 };
 
+/** Last2 encoding characters for the standard encoding */
+static char standard_encoding_chars[] = { '+', '/' };
+
+/** Last 2 encoding characters for the URL-safe encoding */
+static char url_safe_encoding_chars[] = { '-', '_' };
+
+/**
+ * @brief Check the character is alphanumeric in ASCII, regardless of the locale
+ *
+ * @param[in] c Input character
+ * @retval true if the character is alphanumeric
+ * @retval false if the character is not alphanumeric
+*/
+static inline bool is_ascii_alnum(const char c) {
+    return ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9'));
+}
+
 /**
- * @brief Padding
+ * @brief Check the character can't be the 62nd/63rd encoding character
+ *
+ * Alphanumeric characters are the other encoding characters, and null terminates the encoded string.
+ *
+ * @param[in] c Input character
+ * @retval true if the character is not available
+ * @retval false if the character is available
 */
-#define PADDING '='
+static inline bool is_unavailable_char(const char c) {
+    return (c == CHAR_NULL) || is_ascii_alnum(c);
+}
 
 /**
- * @brief Carriage return
+ * @brief Check the character can't be the 62nd/63rd encoding character of an alphabet for decoding
+ *
+ * Padding and CR/LF have their own meanings in the encoded string, so the encoding couldn't be decoded.
+ *
+ * @param[in] c Input character
+ * @retval true if the character is reserved
+ * @retval false if the character is available
 */
-#define CHAR_CR '\x0d'
+static inline bool is_reserved_char(const char c) {
+    return (c == PADDING) || (c == CHAR_CR) || (c == CHAR_LF) || is_unavailable_char(c);
+}
+
 /**
- * @brief Line feed
+ * @brief Initialize the tables of the alphabet without checking the characters
+ *
+ * @param[out] alphabet Alphabet to be initialized
+ * @param[in] c62 62nd encoding character
+ * @param[in] c63 63rd encoding character
 */
-#define CHAR_LF '\x0a'
+static void init_alphabet_tables(B64Alphabet* alphabet, const char c62, const char c63) {
+    const B64Alphabet* base = &b64_std_alphabet;
+    memcpy(alphabet->encoding_table, base->encoding_table, 62);
+    alphabet->encoding_table[62] = c62;
+    alphabet->encoding_table[63] = c63;
+
+    for (int c = 0; c < 256; ++c) {
+        alphabet->decoding_table[c] = DECODE_VALUE(c, (uint8_t)c62, (uint8_t)c63);
+    }
+
+    for (int v = 0; v < 4096; ++v) {
+        alphabet->encoding_pair_table[v][0] = alphabet->encoding_table[v >> 6];
+        alphabet->encoding_pair_table[v][1] = alphabet->encoding_table[v & 0x3f];
+    }
+    for (int c = 0; c < 256; ++c) {
+        const uint8_t value = alphabet->decoding_table[c];
+        for (int k = 0; k < 4; ++k) {
+            alphabet->shifted_decoding_tables[k][c] = (value == INVALID_VALUE) ? SHIFTED_INVALID_VALUE : ((uint32_t)value << (18 - k * 6));
+        }
+    }
+}
+
+bool b64_init_alphabet(B64Alphabet* alphabet, const char last_2_encoding_chars[2]) {
+    const char c62 = last_2_encoding_chars[0];
+    const char c63 = last_2_encoding_chars[1];
+
+    if ((c62 == c63) || is_reserved_char(c62) || is_reserved_char(c63)) {
+        return false;
+    }
+
+    init_alphabet_tables(alphabet, c62, c63);
+
+    return true;
+}
+
 /**
- * @brief Null character
+ * @brief Get the alphabet for the last 2 encoding characters
+ *
+ * An alphabet only for encoding accepts padding and CR/LF as b64_encode() did,
+ * since they are ambiguous only on decoding.
+ *
+ * @param[out] buf Alphabet to be initialized for non-predefined characters
+ * @param[in] last_2_encoding_chars 62nd/63rd encoding characters
+ * @param[in] decoding Whether the alphabet is used for decoding
+ * @return Pointer to the alphabet
+ * @retval NULL if the characters are not available
 */
-#define CHAR_NULL '\0'
+static const B64Alphabet* get_alphabet(B64Alphabet* buf, const char last_2_encoding_chars[2], const bool decoding) {
+    const char c62 = last_2_encoding_chars[0];
+    const char c63 = last_2_encoding_chars[1];
+
+    if ((c62 == standard_encoding_chars[0]) && (c63 == standard_encoding_chars[1])) {
+        return &b64_std_alphabet;
+    }
+    if ((c62 == url_safe_encoding_chars[0]) && (c63 == url_safe_encoding_chars[1])) {
+        return &b64_url_alphabet;
+    }
+
+    if (decoding) {
+        return b64_init_alphabet(buf, last_2_encoding_chars) ? buf : NULL;
+    }
+
+    if ((c62 == c63) || is_unavailable_char(c62) || is_unavailable_char(c63)) {
+        return NULL;
+    }
+    init_alphabet_tables(buf, c62, c63);
+
+    return buf;
+}
 
 /**
  * @brief Get Base64 encoded byte size
@@ -65,7 +278,7 @@ static size_t get_encoded_byte_size(const size_t src_size, const bool use_paddin
 
     // Add size of CRLF if required
     if (line_length > 0) {
-        int num_lines = encoded_size / line_length;
+        size_t num_lines = encoded_size / line_length;
         if ((encoded_size % line_length) == 0) {
             num_lines--;
         }
@@ -79,42 +292,46 @@ static size_t get_encoded_byte_size(const size_t src_size, const bool use_paddin
 /**
  * @brief Encode the first 6 bits in the 3 byte block
  *
+ * @param[in] encoding_table Encoding table
  * @param[in] byte First input byte
  * @return Base64 encoded character
 */
-static inline char encode_to_1st_char(const uint8_t byte) {
+static inline char encode_to_1st_char(const char* encoding_table, const uint8_t byte) {
     return encoding_table[(byte & 0xfc) >> 2];
 }
 
 /**
  * @brief Encode the second 6 bits in the 3 byte block
  *
+ * @param[in] encoding_table Encoding table
  * @param[in] byte1 First input byte in the block
  * @param[in] byte2 Second input byte in the block
  * @return Base64 encoded character
 */
-static inline char encode_to_2nd_char(const uint8_t byte1, const uint8_t byte2) {
+static inline char encode_to_2nd_char(const char* encoding_table, const uint8_t byte1, const uint8_t byte2) {
     return encoding_table[((byte1 & 0x03) << 4) | ((byte2 & 0xf0) >> 4)];
 }
 
 /**
  * @brief Encode the third 6 bits in the 3 byte block
  *
+ * @param[in] encoding_table Encoding table
  * @param[in] byte1 Second input byte in the block
  * @param[in] byte2 Third input byte in the block
  * @return Base64 encoded character
 */
-static inline char encode_to_3rd_char(const uint8_t byte1, const uint8_t byte2) {
+static inline char encode_to_3rd_char(const char* encoding_table, const uint8_t byte1, const uint8_t byte2) {
     return encoding_table[((byte1 & 0x0f) << 2) | ((byte2 & 0xc0) >> 6)];
 }
 
 /**
  * @brief Encode the fourth 6 bits in the 3 byte block
  *
+ * @param[in] encoding_table Encoding table
  * @param[in] byte Third input byte in the block
  * @return Base64 encoded character
 */
-static inline char encode_to_4th_char(const uint8_t byte) {
+static inline char encode_to_4th_char(const char* encoding_table, const uint8_t byte) {
     return encoding_table[byte & 0x3f];
 }
 
@@ -122,38 +339,182 @@ static inline char encode_to_4th_char(const uint8_t byte) {
  * @brief Encode 3 bytes of the input to Base64 encoding characters
  *
  * @param[out] dest Pointer to the Base64 encoded characters
+ * @param[in] encoding_table Encoding table
  * @param[in] src Pointer to the input bytes
  * @param[in] num_remaining_bytes The number of remaining bytes in the input
  * @param[in] use_padding Use padding
+ * @return The number of the encoded characters
 */
-static void encode_to_4chars(char* dest, const uint8_t* src, const int num_remaining_bytes, const bool use_padding) {
-    dest[0] = encode_to_1st_char(src[0]);
+static int encode_to_4chars(char* dest, const char* encoding_table, const uint8_t* src, const size_t num_remaining_bytes, const bool use_padding) {
+    dest[0] = encode_to_1st_char(encoding_table, src[0]);
     switch (num_remaining_bytes) {
         case 1:
-            dest[1] = encode_to_2nd_char(src[0], 0x00);
+            dest[1] = encode_to_2nd_char(encoding_table, src[0], 0x00);
             if (use_padding) {
                 dest[2] = PADDING;
                 dest[3] = PADDING;
-            } else {
-                dest[2] = CHAR_NULL;
-                dest[3] = CHAR_NULL;
+                return 4;
             }
-            break;
+            return 2;
         case 2:
-            dest[1] = encode_to_2nd_char(src[0], src[1]);
-            dest[2] = encode_to_3rd_char(src[1], 0x00);
+            dest[1] = encode_to_2nd_char(encoding_table, src[0], src[1]);
+            dest[2] = encode_to_3rd_char(encoding_table, src[1], 0x00);
             if (use_padding) {
                 dest[3] = PADDING;
-            } else {
-                dest[3] = CHAR_NULL;
+                return 4;
             }
-            break;
+            return 3;
         default:
-            dest[1] = encode_to_2nd_char(src[0], src[1]);
-            dest[2] = encode_to_3rd_char(src[1], src[2]);
-            dest[3] = encode_to_4th_char(src[2]);
-            break;
+            dest[1] = encode_to_2nd_char(encoding_table, src[0], src[1]);
+            dest[2] = encode_to_3rd_char(encoding_table, src[1], src[2]);
+            dest[3] = encode_to_4th_char(encoding_table, src[2]);
+            return 4;
+    }
+}
+
+/**
+ * @brief Write encoded characters, inserting CRLF before the character over the line length
+ *
+ * @param[out] dest Pointer to the buffer
+ * @param[in] chars Encoded characters
+ * @param[in] num_chars The number of the encoded characters
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @param[in,out] column The number of characters in the current line
+ * @return Length of the written string
+*/
+static size_t write_chars_in_lines(char* dest, const char* chars, const size_t num_chars, const size_t line_length, size_t* column) {
+    if (line_length == 0) {
+        memcpy(dest, chars, num_chars);
+        return num_chars;
+    }
+
+    size_t i = 0;
+    size_t buf_index = 0;
+    while (i < num_chars) {
+        // Insert CRLF only if a character follows,
+        // so the encoded string has no trailing CRLF
+        if (*column == line_length) {
+            dest[buf_index] = CHAR_CR;
+            dest[buf_index + 1] = CHAR_LF;
+            buf_index += 2;
+            *column = 0;
+        }
+
+        // Copy the characters up to the end of the line at once
+        size_t num_line_chars = line_length - *column;
+        if (num_line_chars > (num_chars - i)) {
+            num_line_chars = num_chars - i;
+        }
+        memcpy(&dest[buf_index], &chars[i], num_line_chars);
+        buf_index += num_line_chars;
+        i += num_line_chars;
+        *column += num_line_chars;
+    }
+
+    return buf_index;
+}
+
+/**
+ * @brief Encode 3-byte blocks of the input without linebreaks
+ *
+ * @param[out] dest Pointer to the Base64 encoded characters
+ * @param[in] src Pointer to the input bytes
+ * @param[in] num_blocks The number of the 3-byte blocks to be encoded
+ * @param[in] alphabet Alphabet
+ * @return Length of the written string
+*/
+static size_t encode_blocks(char* dest, const uint8_t* src, const size_t num_blocks, const B64Alphabet* alphabet) {
+    const size_t src_size = num_blocks * 3;
+
+    // Encode blocks by SIMD instructions if available
+    size_t i = b64_simd_encode_blocks(dest, src, src_size, alphabet);
+    size_t buf_index = i / 3 * 4;
+
+    // Encode 2 blocks (48 bits) into 8 characters at once by the 12-bit table
+    const char (*pair_table)[2] = alphabet->encoding_pair_table;
+    for (; (src_size - i) >= 6; i += 6) {
+        const uint64_t bits = load_be48(&src[i]);
+        memcpy(&dest[buf_index], pair_table[(bits >> 36) & 0xfff], 2);
+        memcpy(&dest[buf_index + 2], pair_table[(bits >> 24) & 0xfff], 2);
+        memcpy(&dest[buf_index + 4], pair_table[(bits >> 12) & 0xfff], 2);
+        memcpy(&dest[buf_index + 6], pair_table[bits & 0xfff], 2);
+        buf_index += 8;
+    }
+
+    if (i < src_size) {
+        const uint32_t bits = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1] << 8) | src[i + 2];
+        memcpy(&dest[buf_index], pair_table[bits >> 12], 2);
+        memcpy(&dest[buf_index + 2], pair_table[bits & 0xfff], 2);
+        buf_index += 4;
+    }
+
+    return buf_index;
+}
+
+size_t b64_encode_blocks_in_lines(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const size_t line_length, size_t* column) {
+    size_t num_blocks = src_size / 3;
+    if (line_length == 0) {
+        return encode_blocks(dest, src, num_blocks, alphabet);
+    }
+
+    // Encode many lines at once into the buffer on the cache,
+    // then copy them line by line with CRLF
+    char encoded_chars[LINE_BUFFER_BLOCKS * 4];
+
+    size_t i = 0;
+    size_t buf_index = 0;
+    while (num_blocks > 0) {
+        const size_t num_buf_blocks = (num_blocks < LINE_BUFFER_BLOCKS) ? num_blocks : LINE_BUFFER_BLOCKS;
+        const size_t num_chars = encode_blocks(encoded_chars, &src[i], num_buf_blocks, alphabet);
+        buf_index += write_chars_in_lines(&dest[buf_index], encoded_chars, num_chars, line_length, column);
+
+        i += num_buf_blocks * 3;
+        num_blocks -= num_buf_blocks;
+    }
+
+    return buf_index;
+}
+
+size_t b64_encode_last_block_in_lines(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, size_t* column) {
+    if (src_size == 0) {
+        return 0;
+    }
+
+    char encoded_chars[4];
+    const int num_chars = encode_to_4chars(encoded_chars, alphabet->encoding_table, src, src_size, use_padding);
+
+    return write_chars_in_lines(dest, encoded_chars, num_chars, line_length, column);
+}
+
+/**
+ * @brief Encode input bytes to Base64 encoded string in the buffer
+ *
+ * @param[out] dest Pointer to the buffer, which has the size by get_encoded_byte_size()
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet
+ * @param[in] use_padding Use padding
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @return Length of the encoded string
+*/
+static size_t encode_to_buffer(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    // Small inputs by the unrolled routines, without the SIMD dispatch and the line handling
+    if ((line_length == 0) && (src_size <= B64_SMALL_MAX_SIZE)) {
+        return b64_encode_small_input(dest, src, src_size, alphabet, use_padding);
     }
+
+    size_t column = 0;
+
+    size_t buf_index = b64_encode_blocks_in_lines(dest, src, src_size, alphabet, line_length, &column);
+
+    // Encode the remaining 1 or 2 bytes
+    const size_t num_encoded_bytes = src_size / 3 * 3;
+    buf_index += b64_encode_last_block_in_lines(&dest[buf_index], &src[num_encoded_bytes], src_size - num_encoded_bytes, alphabet, use_padding, line_length, &column);
+
+    // Terminate encoded string
+    dest[buf_index] = CHAR_NULL;
+
+    return buf_index;
 }
 
 /**
@@ -162,151 +523,180 @@ static void encode_to_4chars(char* dest, const uint8_t* src, const int num_remai
  * @param[out] length Length of the encoded string
  * @param[in] src Pointer to the input bytes
  * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet
  * @param[in] use_padding Use padding
  * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @param[in] allocator Allocator of the encoded string
  * @return Pointer to the encoded string
  * @retval NULL if encoding failed
 */
-static char* encode(size_t* length, const uint8_t* src, const size_t src_size, const bool use_padding, const size_t line_length) {
+static char* encode(size_t* length, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, const B64Allocator* allocator) {
+    if (alphabet == NULL) {
+        return NULL;
+    }
+
     size_t encoded_byte_size = get_encoded_byte_size(src_size, use_padding, line_length);
     if (encoded_byte_size == 0) {
         return NULL;
     }
 
-    bool insert_crlf = (line_length > 0) ? true : false;
-
-    char* buf = malloc(sizeof(char) * encoded_byte_size);
+    char* buf = allocator->alloc(sizeof(char) * encoded_byte_size, allocator->context);
     if (buf == NULL) {
         return NULL;
     }
 
-    const uint8_t* input_bytes = src;
-    size_t buf_index = 0;
+    *length = encode_to_buffer(buf, src, src_size, alphabet, use_padding, line_length);
 
-    int num_encoded_chars = 0;
-    int64_t num_remaining_bytes = (int64_t)src_size;
+    return buf;
+}
 
-    char encoded_chars[4];
-    while (num_remaining_bytes > 0) {
-        // Convert 3 input characters to 4 base64-encoded characters
-        encode_to_4chars(encoded_chars, input_bytes, num_remaining_bytes, use_padding);
-
-        input_bytes += 3;
-        num_remaining_bytes -= 3;
-
-        size_t num_chars = strlen(encoded_chars);
-        for (size_t i = 0; i < num_chars; ++i) {
-            buf[buf_index] = encoded_chars[i];
-            ++num_encoded_chars;
-            ++buf_index;
-            // Insert CRLF if required
-            // Skip at the end of encoded string
-            if (insert_crlf && (buf_index < (encoded_byte_size - 1))) {
-                if ((num_encoded_chars % line_length) == 0) {
-                    buf[buf_index] = CHAR_CR;
-                    buf[buf_index + 1] = CHAR_LF;
-                    buf_index += 2;
-                }
-            }
-        }
-    }
+#ifdef B64_STATS
+/**
+ * @brief Encode input bytes to Base64 encoded string, recording the call in the statistics
+ *
+ * @param[in] entry Entry point
+ * @param[out] length Length of the encoded string
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet
+ * @param[in] use_padding Use padding
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @param[in] allocator Allocator of the encoded string
+ * @return Pointer to the encoded string
+ * @retval NULL if encoding failed
+*/
+static char* encode_with_stats(const B64StatsEntry entry, size_t* length, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, const B64Allocator* allocator) {
+    const uint64_t start = b64_stats_now();
 
-    // Terminate encoded string
-    buf[buf_index] = CHAR_NULL;
+    char* buf = encode(length, src, src_size, alphabet, use_padding, line_length, allocator);
 
-    *length = strlen(buf);
+    // The error is classified in the same order as encode()
+    B64Result result = B64_SUCCESS;
+    if (buf == NULL) {
+        result = (alphabet == NULL) ? B64_ERROR_INVALID_ARGUMENT :
+            (get_encoded_byte_size(src_size, use_padding, line_length) == 0) ? B64_ERROR_EMPTY_INPUT :
+            B64_ERROR_OUT_OF_MEMORY;
+    }
+    b64_stats_record(entry, src_size, (buf != NULL) ? *length : 0, result, start);
 
     return buf;
 }
 
 /**
- * @brief Set the last 2 (62nd and 63rd) characters in the encoding table
- *
- * @param[in] encoding_char_62nd 62nd encoding character
- * @param[in] encoding_char_63rd 63rd encoding character
+ * @brief Encode by the entry point recorded in the statistics
+*/
+#define ENCODE(entry, ...) encode_with_stats((entry), __VA_ARGS__)
+#else
+/**
+ * @brief Encode by the entry point, not recorded without B64_STATS
 */
-static inline void set_last2_encoding_chars(const char encoding_char_62nd, const char encoding_char_63rd) {
-    encoding_table[62] = encoding_char_62nd;
-    encoding_table[63] = encoding_char_63rd;
+#define ENCODE(entry, ...) encode(__VA_ARGS__)
+#endif
+
+size_t b64_get_encoded_size(const size_t src_size, const bool use_padding, const size_t line_length) {
+    return get_encoded_byte_size(src_size, use_padding, line_length);
 }
 
-/** Last2 encoding characters for the standard encoding */
-static char standard_encoding_chars[] = { '+', '/' };
+B64Result b64_encode_into(size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
 
-/** Last 2 encoding characters for the URL-safe encoding */
-static char url_safe_encoding_chars[] = { '-', '_' };
+    size_t encoded_byte_size = get_encoded_byte_size(src_size, use_padding, line_length);
+    if (encoded_byte_size == 0) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+    if (dest_size < encoded_byte_size) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *length = encode_to_buffer(dest, src, src_size, alphabet, use_padding, line_length);
+
+    return B64_SUCCESS;
+}
 
 char* b64_encode(size_t* length, const void* src, const size_t src_size, char last_2_encoding_chars[2], const bool use_padding, const size_t line_length) {
-    set_last2_encoding_chars(last_2_encoding_chars[0], last_2_encoding_chars[1]);
+    B64Alphabet buf;
+    const B64Alphabet* alphabet = get_alphabet(&buf, last_2_encoding_chars, false);
 
-    return encode(length, src, src_size, use_padding, line_length);
+    return ENCODE(B64_STATS_ENCODE, length, src, src_size, alphabet, use_padding, line_length, &b64_default_allocator);
+}
+
+char* b64_encode_with_alphabet(size_t* length, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    return ENCODE(B64_STATS_ENCODE, length, src, src_size, alphabet, use_padding, line_length, &b64_default_allocator);
+}
+
+char* b64_encode_with_allocator(size_t* length, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, const B64Allocator* allocator) {
+    return ENCODE(B64_STATS_ENCODE, length, src, src_size, alphabet, use_padding, line_length, allocator);
 }
 
 char* b64_std_encode(size_t* length, const void* src, const size_t src_size) {
-    return b64_encode(length, src, src_size, standard_encoding_chars, true, 0);
+    return ENCODE(B64_STATS_STD_ENCODE, length, src, src_size, &b64_std_alphabet, true, 0, &b64_default_allocator);
 }
 
 char* b64_url_encode(size_t* length, const void* src, const size_t src_size) {
-    return b64_encode(length, src, src_size, url_safe_encoding_chars, false, 0);
+    return ENCODE(B64_STATS_URL_ENCODE, length, src, src_size, &b64_url_alphabet, false, 0, &b64_default_allocator);
 }
 
 char* b64_mime_encode(size_t* length, const void* src, const size_t src_size) {
-    return b64_encode(length, src, src_size, standard_encoding_chars, true, 76);
+    return ENCODE(B64_STATS_MIME_ENCODE, length, src, src_size, &b64_std_alphabet, true, B64_MIME_LINE_LENGTH, &b64_default_allocator);
 }
 
 
 /**
- * @brief Verify the input character
+ * @brief Decode a input character with the decoding table
  *
+ * @param[in] decoding_table Decoding table
  * @param[in] c Input character
- * @retval true if the character is valid as Base64 character
- * @retval false if the character is not valid
+ * @return Decoded byte value, 0 to 63
+ * @retval INVALID_VALUE if the character is not in the alphabet
 */
-static inline bool is_valid_b64_char(const char c) {
-    if (isalnum(c) || (c == encoding_table[62]) || (c == encoding_table[63])) {
-        return true;
-    }
-
-    return false;
+static inline uint8_t decode_b64_char(const uint8_t* decoding_table, const char c) {
+    return decoding_table[(uint8_t)c];
 }
 
 /**
- * @brief Verify the input string
+ * @brief Verify the input character
  *
- * @param[in] str Input string
- * @retval true if the string is valid as Base64 string
- * @retval false if the string is not valid
+ * @param[in] decoding_table Decoding table
+ * @param[in] c Input character
+ * @retval true if the character is valid as Base64 character
+ * @retval false if the character is not valid
 */
-static bool is_valid_b64_string(const char* str) {
-    size_t length = strlen(str);
+static inline bool is_valid_b64_char(const uint8_t* decoding_table, const char c) {
+    return decode_b64_char(decoding_table, c) != INVALID_VALUE;
+}
+
+size_t b64_count_encoding_chars(const char* src, const size_t src_length, const B64Alphabet* alphabet, bool* padding_found) {
+    const uint8_t* decoding_table = alphabet->decoding_table;
 
-    for (size_t i = 0; i < length; ++i) {
-        const char c = str[i];
-        if (!is_valid_b64_char(c) && (c != CHAR_CR) && (c != CHAR_LF) && (c != PADDING)) {
-            return false;
+    size_t num_encoding_chars = 0;
+    size_t i = b64_simd_count_chars(&num_encoding_chars, src, src_length, alphabet);
+    for (; i < src_length; ++i) {
+        if (src[i] == PADDING) {
+            *padding_found = true;
+            return num_encoding_chars;
         }
+        num_encoding_chars += is_valid_b64_char(decoding_table, src[i]);
     }
 
-    return true;
+    *padding_found = false;
+
+    return num_encoding_chars;
 }
 
 /**
- * @brief Get Base64 decoded byte size
+ * @brief Get Base64 decoded byte size from the number of the encoding characters
  *
- * @param[in] src Pointer to the input string
- * @return Byte size of the decoded bytes
+ * @param[out] size Byte size of the decoded bytes
+ * @param[in] num_encoding_chars The number of the encoding characters
+ * @retval B64_SUCCESS if the size is available
+ * @retval B64_ERROR_EMPTY_INPUT if there are no encoding characters
+ * @retval B64_ERROR_INVALID_LENGTH if the number of encoding characters is invalid
 */
-static size_t get_decoded_size(const char* src) {
-    size_t src_size = strlen(src);
-    if (src_size == 0) {
-        return 0;
-    }
-
-    size_t num_encoding_chars = 0;
-    for (size_t i = 0; i < src_size; ++i) {
-        if (is_valid_b64_char(src[i])) {
-            num_encoding_chars++;
-        }
+static B64Result get_decoded_size(size_t* size, const size_t num_encoding_chars) {
+    if (num_encoding_chars == 0) {
+        return B64_ERROR_EMPTY_INPUT;
     }
 
     size_t decoded_size = num_encoding_chars / 4 * 3;
@@ -315,87 +705,69 @@ static size_t get_decoded_size(const char* src) {
         if (remaining_bytes == 1) {
             // It means that the remaining length of the input is less than
             // 1 byte (6bit), therefore decoding fails
-            return 0;
+            return B64_ERROR_INVALID_LENGTH;
         }
         decoded_size += (remaining_bytes - 1);
     }
 
-    return decoded_size;
-}
-
-/**
- * @brief Decode a input character with the encoding table
- *
- * @param[in] c Input character
- * @return Decoded byte value, 0 to 63
- * @retval 64 if decoding failed
-*/
-static uint8_t decode_b64_char(const char c) {
-    uint8_t index;
-    for (index = 0; index < sizeof(encoding_table); ++index) {
-        if (c == encoding_table[index]) {
-            return index;
-        }
-    }
+    *size = decoded_size;
 
-    // Not reached here,
-    // because only valid character is passed
-    return sizeof(encoding_table);
+    return B64_SUCCESS;
 }
 
 /**
- * @brief Decode the first 8 bits in the 4 encoded characters
+ * @brief Decode the first 8 bits in the 4 decoded 6-bit values
  *
- * @param[in] char1 First input character in the block
- * @param[in] char2 Second input character in the block
+ * @param[in] value1 First decoded value in the block
+ * @param[in] value2 Second decoded value in the block
  * @return Base64 decoded byte
 */
-static inline uint8_t decode_to_1st_byte(const char char1, const char char2) {
-    return ((decode_b64_char(char1) & 0x3f) << 2) | ((decode_b64_char(char2) & 0x30) >> 4);
+static inline uint8_t decode_to_1st_byte(const uint8_t value1, const uint8_t value2) {
+    return (uint8_t)(((value1 & 0x3f) << 2) | ((value2 & 0x30) >> 4));
 }
 
 /**
- * @brief Decode the second 8 bits in the 4 encoded characters
+ * @brief Decode the second 8 bits in the 4 decoded 6-bit values
  *
- * @param[in] char1 Second input character in the block
- * @param[in] char2 Third input character in the block
+ * @param[in] value1 Second decoded value in the block
+ * @param[in] value2 Third decoded value in the block
  * @return Base64 decoded byte
 */
-static inline uint8_t decode_to_2nd_byte(const char char1, const char char2) {
-    return ((decode_b64_char(char1) & 0x0f) << 4) | ((decode_b64_char(char2) & 0x3c) >> 2);
+static inline uint8_t decode_to_2nd_byte(const uint8_t value1, const uint8_t value2) {
+    return (uint8_t)(((value1 & 0x0f) << 4) | ((value2 & 0x3c) >> 2));
 }
 
 /**
- * @brief Decode the third 8 bits in the 4 encoded characters
+ * @brief Decode the third 8 bits in the 4 decoded 6-bit values
  *
- * @param[in] char1 Third input character in the block
- * @param[in] char2 Fourth input character in the block
+ * @param[in] value1 Third decoded value in the block
+ * @param[in] value2 Fourth decoded value in the block
  * @return Base64 decoded byte
 */
-static inline uint8_t decode_to_3rd_byte(const char char1, const char char2) {
-    return ((decode_b64_char(char1) & 0x03) << 6) | (decode_b64_char(char2) & 0x3f);
+static inline uint8_t decode_to_3rd_byte(const uint8_t value1, const uint8_t value2) {
+    return (uint8_t)(((value1 & 0x03) << 6) | (value2 & 0x3f));
 }
 
 /**
- * @brief Encode 4 characters of the input string to original bytes
+ * @brief Decode 4 decoded 6-bit values to original bytes
  *
  * @param[out] dest Pointer to the decoded bytes
- * @param[in] src Pointer to the input string
- * @param[in] num_to_decode The number of remaining bytes in the input
+ * @param[in] values Pointer to the decoded 6-bit values
+ * @param[in] num_to_decode The number of values to be decoded
 */
-static void decode_to_3bytes(uint8_t* dest, const char* src, const int num_to_decode) {
+static void decode_to_3bytes(uint8_t* dest, const uint8_t* values, const int num_to_decode) {
     switch (num_to_decode) {
         case 2:
-            dest[0] = decode_to_1st_byte(src[0], src[1]);
+            dest[0] = decode_to_1st_byte(values[0], values[1]);
             break;
         case 3:
-            dest[0] = decode_to_1st_byte(src[0], src[1]);
-            dest[1] = decode_to_2nd_byte(src[1], src[2]);
+            dest[0] = decode_to_1st_byte(values[0], values[1]);
+            dest[1] = decode_to_2nd_byte(values[1], values[2]);
             break;
         case 4:
-            dest[0] = decode_to_1st_byte(src[0], src[1]);
-            dest[1] = decode_to_2nd_byte(src[1], src[2]);
-            dest[2] = decode_to_3rd_byte(src[2], src[3]);
+            dest[0] = decode_to_1st_byte(values[0], values[1]);
+            dest[1] = decode_to_2nd_byte(values[1], values[2]);
+            dest[2] = decode_to_3rd_byte(values[2], values[3]);
             break;
         default:
             break;
@@ -403,84 +775,596 @@ static void decode_to_3bytes(uint8_t* dest, const char* src, const int num_to_de
 }
 
 /**
- * @brief Decode input Base64 string to byte array
+ * @brief Get the upper bound of Base64 decoded byte size from the input length
  *
- * @param[out] size Byte size of the decoded byte array
- * @param[in] src Pointer to the input Base64 string
- * @param[in] validate Validate the input string
- * @return Pointer to the decoded byte array
- * @retval NULL if decoding failed
+ * @param[in] src_length Length of the input string
+ * @return Upper bound of the byte size of the decoded bytes
+*/
+static inline size_t get_max_decoded_size(const size_t src_length) {
+    return (src_length / 4 * 3) + ((src_length % 4) * 3 / 4);
+}
+
+/**
+ * @brief Decode a 4-character block by the shifted decoding tables
+ *
+ * @param[in] tables Shifted decoding tables
+ * @param[in] chars Pointer to the 4 characters
+ * @return 24-bit decoded block, SHIFTED_INVALID_VALUE is set if any character is out of the alphabet
+*/
+static inline uint32_t decode_block_by_tables(const uint32_t (*tables)[256], const uint8_t* chars) {
+    return tables[0][chars[0]] | tables[1][chars[1]] | tables[2][chars[2]] | tables[3][chars[3]];
+}
+
+/**
+ * @brief Write a 24-bit decoded block into 3 bytes
+ *
+ * @param[out] dest Pointer to the decoded bytes
+ * @param[in] block 24-bit decoded block
+*/
+static inline void write_decoded_block(uint8_t* dest, const uint32_t block) {
+    dest[0] = (uint8_t)(block >> 16);
+    dest[1] = (uint8_t)(block >> 8);
+    dest[2] = (uint8_t)block;
+}
+
+/**
+ * @brief Decode 4-character blocks by the shifted decoding tables without branches per character
+ *
+ * The values of the characters are combined by OR, and the bit for characters out of the alphabet
+ * is checked once for 2 blocks. Each block is read before its decoded bytes are written.
+ *
+ * @param[out] dest Pointer to the decoded bytes
+ * @param[in] dest_size Byte size of the output buffer
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @return Length of the decoded input, multiple of 4
 */
-static void* decode(size_t* size, const char* src, const bool validate) {
-    if (validate) {
-        if (!is_valid_b64_string(src)) {
-            return NULL;
+static size_t decode_blocks_by_tables(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    const uint32_t (*tables)[256] = alphabet->shifted_decoding_tables;
+    const uint8_t* chars = (const uint8_t*)src;
+
+    size_t i = 0;
+    size_t j = 0;
+    for (; ((src_length - i) >= 8) && ((dest_size - j) >= 6); i += 8, j += 6) {
+        const uint32_t block1 = decode_block_by_tables(tables, &chars[i]);
+        const uint32_t block2 = decode_block_by_tables(tables, &chars[i + 4]);
+        if (((block1 | block2) & SHIFTED_INVALID_VALUE) != 0) {
+            break;
         }
+        write_decoded_block(&dest[j], block1);
+        write_decoded_block(&dest[j + 3], block2);
     }
 
-    size_t decoded_size = get_decoded_size(src);
-    if (decoded_size == 0) {
-        return NULL;
+    // A block before the invalid character, or the last block
+    if (((src_length - i) >= 4) && ((dest_size - j) >= 3)) {
+        const uint32_t block = decode_block_by_tables(tables, &chars[i]);
+        if ((block & SHIFTED_INVALID_VALUE) == 0) {
+            write_decoded_block(&dest[j], block);
+            i += 4;
+        }
     }
 
-    uint8_t* buf = malloc(sizeof(uint8_t) * decoded_size);
-    if (buf == NULL) {
-        return NULL;
+    return i;
+}
+
+/**
+ * @brief Decode 4-character blocks at the beginning of the input
+ *
+ * Decoding stops at the first block including a character out of the alphabet.
+ *
+ * @param[out] dest Pointer to the decoded bytes
+ * @param[in] dest_size Byte size of the output buffer
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @return Length of the decoded input, multiple of 4
+*/
+static inline size_t decode_blocks(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    // Decode blocks by SIMD instructions if available, then the rest by the tables
+    const size_t simd_length = b64_simd_decode_blocks(dest, dest_size, src, src_length, alphabet);
+    const size_t simd_size = simd_length / 4 * 3;
+
+    return simd_length + decode_blocks_by_tables(&dest[simd_size], dest_size - simd_size, &src[simd_length], src_length - simd_length, alphabet);
+}
+
+B64Result b64_decode_chunk(B64DecodeState* state, size_t* size, uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length) {
+    const B64Alphabet* alphabet = state->alphabet;
+    const uint8_t* decoding_table = alphabet->decoding_table;
+    const bool validate = state->validate;
+    const bool strict = state->strict;
+
+    *size = 0;
+
+    // The rest is ignored after the padding without validation
+    bool padding_found = state->padding_found;
+    if (padding_found && !validate) {
+        return B64_SUCCESS;
     }
 
-    const char* input_char = src;
+    uint8_t* decoded_values = state->decoded_values;
+    size_t num_to_decode = state->num_decoded_values;
+    size_t num_paddings = state->num_paddings;
+
+    size_t i = 0;
     size_t buf_index = 0;
+    if (!padding_found && (num_to_decode == 0)) {
+        // Decode blocks by SIMD instructions or the shifted tables
+        i = decode_blocks(dest, dest_size, src, src_length, alphabet);
+        buf_index = i / 4 * 3;
+    }
 
-    int64_t num_remaining_chars = (int64_t)strlen(src);
+    B64Result result = B64_SUCCESS;
+    for (; i < src_length; ++i) {
+        const uint8_t value = decode_b64_char(decoding_table, src[i]);
+        if ((value != INVALID_VALUE) && !padding_found) {
+            decoded_values[num_to_decode] = value;
+            ++num_to_decode;
+
+            if (num_to_decode == 4) {
+                if ((dest_size - buf_index) < 3) {
+                    result = B64_ERROR_BUFFER_TOO_SMALL;
+                    break;
+                }
+                // Convert 4 input characters to 3 base64-decoded bytes
+                decode_to_3bytes(&dest[buf_index], decoded_values, num_to_decode);
+                buf_index += 3;
+                num_to_decode = 0;
+            }
+            continue;
+        }
 
-    char decoding_chars[4];
-    while (num_remaining_chars > 0) {
-        const int max_num_to_decode = (num_remaining_chars >= 4) ? 4 : num_remaining_chars;
-        int num_to_decode = 0;
-        while (num_to_decode < max_num_to_decode) {
-            // Finish decoding when reached to null or padding character
-            if ((*input_char == CHAR_NULL) || (*input_char == PADDING)) {
+        if (strict) {
+            // Only the padding completing the last block is accepted
+            if ((src[i] != PADDING) || !state->require_padding || (num_to_decode < 2) || ((num_to_decode + num_paddings) >= 4)) {
+                result = ((src[i] == PADDING) || (value != INVALID_VALUE)) ? B64_ERROR_INVALID_PADDING : B64_ERROR_INVALID_CHAR;
                 break;
             }
-            // Put a character to be decoded into temporal buffer
-            if (is_valid_b64_char(*input_char)) {
-                decoding_chars[num_to_decode] = *input_char;
-                ++input_char;
-                ++num_to_decode;
-            } else {
-                // Skip non encoding characters or CRLF
-                ++input_char;
-                continue;
+            padding_found = true;
+            ++num_paddings;
+            continue;
+        }
+
+        if (src[i] == PADDING) {
+            // Finish decoding when reached to padding character,
+            // the rest is only validated
+            padding_found = true;
+            if (!validate) {
+                break;
             }
+            continue;
+        }
+
+        if (validate && (value == INVALID_VALUE) && (src[i] != CHAR_CR) && (src[i] != CHAR_LF)) {
+            result = B64_ERROR_INVALID_CHAR;
+            break;
+        }
+
+        // Skip non encoding characters or CRLF,
+        // then resume decoding by blocks if it is at the boundary of the blocks
+        if (!padding_found && (num_to_decode == 0)) {
+            const size_t decoded_length = decode_blocks(&dest[buf_index], dest_size - buf_index, &src[i + 1], src_length - (i + 1), alphabet);
+            i += decoded_length;
+            buf_index += decoded_length / 4 * 3;
+        }
+    }
+
+    state->num_decoded_values = num_to_decode;
+    state->padding_found = padding_found;
+    state->num_paddings = num_paddings;
+    state->decoded_size += buf_index;
+    state->num_read_chars += (result == B64_SUCCESS) ? src_length : i;
+
+    *size = buf_index;
+
+    return result;
+}
+
+B64Result b64_decode_last_block(B64DecodeState* state, size_t* size, uint8_t* dest, const size_t dest_size) {
+    const size_t num_to_decode = state->num_decoded_values;
+
+    *size = 0;
+
+    if ((state->decoded_size == 0) && (num_to_decode == 0)) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+    if (num_to_decode == 1) {
+        // It means that the remaining length of the input is less than
+        // 1 byte (6bit), therefore decoding fails
+        return B64_ERROR_INVALID_LENGTH;
+    }
+
+    if (state->strict && (num_to_decode > 1)) {
+        if (state->require_padding && ((num_to_decode + state->num_paddings) != 4)) {
+            return B64_ERROR_INVALID_PADDING;
         }
+        // Unused bits of the last character must be 0 in the canonical form
+        const uint8_t unused_bits_mask = (num_to_decode == 2) ? 0x0f : 0x03;
+        if ((state->decoded_values[num_to_decode - 1] & unused_bits_mask) != 0) {
+            return B64_ERROR_NON_ZERO_TRAILING_BITS;
+        }
+    }
 
-        // Convert 4 input characters to 3 base64-decoded bytes
-        decode_to_3bytes(&buf[buf_index], decoding_chars, num_to_decode);
+    // Convert the remaining characters
+    if (num_to_decode > 1) {
+        if (dest_size < (num_to_decode - 1)) {
+            return B64_ERROR_BUFFER_TOO_SMALL;
+        }
+        decode_to_3bytes(dest, state->decoded_values, (int)num_to_decode);
+        *size = num_to_decode - 1;
+    }
+
+    state->num_decoded_values = 0;
+    state->decoded_size += *size;
+
+    return B64_SUCCESS;
+}
 
-        buf_index += (num_to_decode - 1);
+/**
+ * @brief Set the detail of the result if required
+ *
+ * @param[out] error Detail of the result, nothing is done with NULL
+ * @param[in] code Result
+ * @param[in] offset Offset of the offending character
+ * @param[in] decoded_size Byte size of the decoded byte array
+*/
+static inline void set_error(B64Error* error, const B64Result code, const size_t offset, const size_t decoded_size) {
+    if (error != NULL) {
+        error->code = code;
+        error->offset = offset;
+        error->decoded_size = decoded_size;
+    }
+}
 
-        num_remaining_chars -= 4;
+/**
+ * @brief Decode input Base64 string to byte array in the buffer
+ *
+ * Validation, skipping CRLF (or non encoding characters if not validated)
+ * and decoding are done in a single pass over the input.
+ *
+ * @param[out] size Byte size of the decoded byte array
+ * @param[out] dest Pointer to the buffer
+ * @param[in] dest_size Byte size of the buffer
+ * @param[in] src Pointer to the input Base64 string
+ * @param[in] src_length Length of the input string
+ * @param[in,out] state Initialized state of the decoding
+ * @param[out] error Detail of the result, can be NULL
+ * @return Result of the decoding
+*/
+static B64Result decode_to_buffer(size_t* size, uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, B64DecodeState* state, B64Error* error) {
+    size_t decoded_size;
+    B64Result result = b64_decode_chunk(state, &decoded_size, dest, dest_size, src, src_length);
+    if (result == B64_SUCCESS) {
+        size_t last_size;
+        result = b64_decode_last_block(state, &last_size, &dest[decoded_size], dest_size - decoded_size);
+        if (result == B64_SUCCESS) {
+            *size = decoded_size + last_size;
+        }
     }
 
-    *size = decoded_size;
+    set_error(error, result, state->num_read_chars, state->decoded_size);
+
+    return result;
+}
+
+/**
+ * @brief Decode input Base64 string to byte array allocated by the allocator
+ *
+ * @param[out] size Byte size of the decoded byte array
+ * @param[in] src Pointer to the input Base64 string
+ * @param[in] src_length Length of the input string
+ * @param[in,out] state Initialized state of the decoding
+ * @param[in] allocator Allocator of the decoded byte array
+ * @param[out] error Detail of the result, can be NULL
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+*/
+static void* decode_with_state(size_t* size, const char* src, const size_t src_length, B64DecodeState* state, const B64Allocator* allocator, B64Error* error) {
+    // Allocate the upper bound size to avoid counting characters in advance
+    size_t buf_size = get_max_decoded_size(src_length);
+    if (buf_size == 0) {
+        // Less than 2 characters never succeed, decoded only to classify the error
+        if (error != NULL) {
+            uint8_t empty_buf[1];
+            decode_to_buffer(size, empty_buf, 0, src, src_length, state, error);
+        }
+        return NULL;
+    }
+
+    uint8_t* buf = allocator->alloc(sizeof(uint8_t) * buf_size, allocator->context);
+    if (buf == NULL) {
+        set_error(error, B64_ERROR_OUT_OF_MEMORY, 0, 0);
+        return NULL;
+    }
+
+    if (decode_to_buffer(size, buf, buf_size, src, src_length, state, error) != B64_SUCCESS) {
+        allocator->free(buf, allocator->context);
+        return NULL;
+    }
 
     return (void*)buf;
 }
 
+/**
+ * @brief Decode input Base64 string to byte array
+ *
+ * @param[out] size Byte size of the decoded byte array
+ * @param[in] src Pointer to the input Base64 string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @param[in] validate Validate the input string, or require the padding in the strict mode
+ * @param[in] strict Accept only the canonical form
+ * @param[in] allocator Allocator of the decoded byte array
+ * @param[out] error Detail of the result, can be NULL
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+*/
+static void* decode(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const bool strict, const B64Allocator* allocator, B64Error* error) {
+    if ((src == NULL) || (alphabet == NULL)) {
+        set_error(error, B64_ERROR_INVALID_ARGUMENT, 0, 0);
+        return NULL;
+    }
+
+    B64DecodeState state;
+    if (strict) {
+        b64_decode_init_strict(&state, alphabet, validate);
+    } else {
+        b64_decode_init(&state, alphabet, validate);
+    }
+
+    return decode_with_state(size, src, src_length, &state, allocator, error);
+}
+
+#ifdef B64_STATS
+/**
+ * @brief Decode input Base64 string to byte array, recording the call in the statistics
+ *
+ * @param[in] entry Entry point
+ * @param[out] size Byte size of the decoded byte array
+ * @param[in] src Pointer to the input Base64 string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @param[in] validate Validate the input string, or require the padding in the strict mode
+ * @param[in] strict Accept only the canonical form
+ * @param[in] allocator Allocator of the decoded byte array
+ * @param[out] error Detail of the result, can be NULL
+ * @return Pointer to the decoded byte array
+ * @retval NULL if decoding failed
+*/
+static void* decode_with_stats(const B64StatsEntry entry, size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const bool strict, const B64Allocator* allocator, B64Error* error) {
+    const uint64_t start = b64_stats_now();
+
+    // The error is always required to classify it
+    B64Error error_buf;
+    B64Error* stats_error = (error != NULL) ? error : &error_buf;
+    void* buf = decode(size, src, src_length, alphabet, validate, strict, allocator, stats_error);
+
+    b64_stats_record(entry, src_length, (buf != NULL) ? *size : 0, (buf != NULL) ? B64_SUCCESS : stats_error->code, start);
+
+    return buf;
+}
+
+/**
+ * @brief Decode by the entry point recorded in the statistics
+*/
+#define DECODE(entry, ...) decode_with_stats((entry), __VA_ARGS__)
+#else
+/**
+ * @brief Decode by the entry point, not recorded without B64_STATS
+*/
+#define DECODE(entry, ...) decode(__VA_ARGS__)
+#endif
+
+size_t b64_get_decoded_size(const char* src, const B64Alphabet* alphabet) {
+    return b64_get_decoded_size_n(src, strlen(src), alphabet);
+}
+
+size_t b64_get_decoded_size_n(const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    // Count encoding characters until the padding, as decoding finishes there
+    bool padding_found;
+    const size_t num_encoding_chars = b64_count_encoding_chars(src, src_length, alphabet, &padding_found);
+
+    size_t decoded_size;
+    if (get_decoded_size(&decoded_size, num_encoding_chars) != B64_SUCCESS) {
+        return 0;
+    }
+
+    return decoded_size;
+}
+
+size_t b64_get_decoded_size_unwrapped(const char* src, const size_t src_length) {
+    // Only the trailing padding is excluded, as all other characters are encoding characters
+    size_t num_encoding_chars = src_length;
+    for (int i = 0; (i < 2) && (num_encoding_chars > 0) && (src[num_encoding_chars - 1] == PADDING); ++i) {
+        --num_encoding_chars;
+    }
+    // More than 2 padding characters (e.g. "====", "Q===") are never decodable
+    if ((num_encoding_chars > 0) && (src[num_encoding_chars - 1] == PADDING)) {
+        return 0;
+    }
+
+    size_t decoded_size;
+    if (get_decoded_size(&decoded_size, num_encoding_chars) != B64_SUCCESS) {
+        return 0;
+    }
+
+    return decoded_size;
+}
+
+B64Result b64_decode_into(size_t* size, void* dest, const size_t dest_size, const char* src, const B64Alphabet* alphabet, const bool validate) {
+    if (src == NULL) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    return b64_decode_into_n(size, dest, dest_size, src, strlen(src), alphabet, validate);
+}
+
+B64Result b64_decode_into_n(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Small inputs by the unrolled routines, falling back to the general decoding
+    // for linebreaks, the padding in the middle and the errors to be classified in the same way
+    if (validate && (src_length <= B64_SMALL_MAX_LENGTH) &&
+        (b64_decode_small_input(size, dest, dest_size, src, src_length, alphabet) == B64_SUCCESS)) {
+        return B64_SUCCESS;
+    }
+
+    B64DecodeState state;
+    b64_decode_init(&state, alphabet, validate);
+
+    return decode_to_buffer(size, dest, dest_size, src, src_length, &state, NULL);
+}
+
+B64Result b64_decode_in_place(size_t* size, char* buf, const B64Alphabet* alphabet, const bool validate) {
+    if (buf == NULL) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    return b64_decode_in_place_n(size, buf, strlen(buf), alphabet, validate);
+}
+
+B64Result b64_decode_in_place_n(size_t* size, char* buf, const size_t length, const B64Alphabet* alphabet, const bool validate) {
+    if ((buf == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Every block is read before its decoded bytes are written,
+    // and the write position never overtakes the read position (3 bytes per 4 characters)
+    B64DecodeState state;
+    b64_decode_init(&state, alphabet, validate);
+
+    return decode_to_buffer(size, (uint8_t*)buf, length, buf, length, &state, NULL);
+}
+
+void* b64_decode_strict(size_t* size, const char* src, const B64Alphabet* alphabet, const bool use_padding) {
+    return b64_decode_strict_with_allocator(size, src, alphabet, use_padding, &b64_default_allocator);
+}
+
+void* b64_decode_strict_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool use_padding) {
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, use_padding, true, &b64_default_allocator, NULL);
+}
+
+void* b64_decode_strict_with_allocator(size_t* size, const char* src, const B64Alphabet* alphabet, const bool use_padding, const B64Allocator* allocator) {
+    if (src == NULL) {
+        return NULL;
+    }
+
+    return b64_decode_strict_with_allocator_n(size, src, strlen(src), alphabet, use_padding, allocator);
+}
+
+void* b64_decode_strict_with_allocator_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool use_padding, const B64Allocator* allocator) {
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, use_padding, true, allocator, NULL);
+}
+
+B64Result b64_decode_into_strict(size_t* size, void* dest, const size_t dest_size, const char* src, const B64Alphabet* alphabet, const bool use_padding) {
+    if (src == NULL) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    return b64_decode_into_strict_n(size, dest, dest_size, src, strlen(src), alphabet, use_padding);
+}
+
+B64Result b64_decode_into_strict_n(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool use_padding) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    B64DecodeState state;
+    b64_decode_init_strict(&state, alphabet, use_padding);
+
+    return decode_to_buffer(size, dest, dest_size, src, src_length, &state, NULL);
+}
+
 void* b64_decode(size_t* size, const char* src, char last_2_encoding_chars[2], const bool validate) {
-    set_last2_encoding_chars(last_2_encoding_chars[0], last_2_encoding_chars[1]);
+    return b64_decode_n(size, src, strlen(src), last_2_encoding_chars, validate);
+}
+
+void* b64_decode_n(size_t* size, const char* src, const size_t src_length, char last_2_encoding_chars[2], const bool validate) {
+    B64Alphabet buf;
+    const B64Alphabet* alphabet = get_alphabet(&buf, last_2_encoding_chars, true);
+
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, validate, false, &b64_default_allocator, NULL);
+}
+
+void* b64_decode_with_alphabet(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate) {
+    return DECODE(B64_STATS_DECODE, size, src, strlen(src), alphabet, validate, false, &b64_default_allocator, NULL);
+}
+
+void* b64_decode_with_alphabet_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate) {
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, validate, false, &b64_default_allocator, NULL);
+}
+
+void* b64_decode_with_allocator(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator) {
+    return DECODE(B64_STATS_DECODE, size, src, strlen(src), alphabet, validate, false, allocator, NULL);
+}
+
+void* b64_decode_with_allocator_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator) {
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, validate, false, allocator, NULL);
+}
+
+void* b64_decode_with_error(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate, B64Error* error) {
+    return DECODE(B64_STATS_DECODE, size, src, strlen(src), alphabet, validate, false, &b64_default_allocator, error);
+}
 
-    return decode(size, src, validate);
+void* b64_decode_with_error_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, B64Error* error) {
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, validate, false, &b64_default_allocator, error);
+}
+
+void* b64_decode_with_allocator_and_error(size_t* size, const char* src, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator, B64Error* error) {
+    return DECODE(B64_STATS_DECODE, size, src, strlen(src), alphabet, validate, false, allocator, error);
+}
+
+void* b64_decode_with_allocator_and_error_n(size_t* size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const B64Allocator* allocator, B64Error* error) {
+    return DECODE(B64_STATS_DECODE, size, src, src_length, alphabet, validate, false, allocator, error);
 }
 
 void* b64_std_decode(size_t* size, const char* src) {
-    return b64_decode(size, src, standard_encoding_chars, true);
+    return DECODE(B64_STATS_STD_DECODE, size, src, strlen(src), &b64_std_alphabet, true, false, &b64_default_allocator, NULL);
+}
+
+void* b64_std_decode_n(size_t* size, const char* src, const size_t src_length) {
+    return DECODE(B64_STATS_STD_DECODE, size, src, src_length, &b64_std_alphabet, true, false, &b64_default_allocator, NULL);
 }
 
 void* b64_url_decode(size_t* size, const char* src) {
-    return b64_decode(size, src, url_safe_encoding_chars, true);
+    return DECODE(B64_STATS_URL_DECODE, size, src, strlen(src), &b64_url_alphabet, true, false, &b64_default_allocator, NULL);
+}
+
+void* b64_url_decode_n(size_t* size, const char* src, const size_t src_length) {
+    return DECODE(B64_STATS_URL_DECODE, size, src, src_length, &b64_url_alphabet, true, false, &b64_default_allocator, NULL);
 }
 
 void* b64_mime_decode(size_t* size, const char* src) {
-    return b64_decode(size, src, standard_encoding_chars, false);
+    return DECODE(B64_STATS_MIME_DECODE, size, src, strlen(src), &b64_std_alphabet, false, false, &b64_default_allocator, NULL);
+}
+
+void* b64_mime_decode_n(size_t* size, const char* src, const size_t src_length) {
+    return DECODE(B64_STATS_MIME_DECODE, size, src, src_length, &b64_std_alphabet, false, false, &b64_default_allocator, NULL);
+}
+
+const char* b64_result_string(const B64Result result) {
+    switch (result) {
+        case B64_SUCCESS:
+            return "success";
+        case B64_ERROR_INVALID_ARGUMENT:
+            return "invalid argument";
+        case B64_ERROR_EMPTY_INPUT:
+            return "empty input";
+        case B64_ERROR_INVALID_CHAR:
+            return "invalid character";
+        case B64_ERROR_INVALID_LENGTH:
+            return "invalid number of encoding characters";
+        case B64_ERROR_BUFFER_TOO_SMALL:
+            return "output buffer too small";
+        case B64_ERROR_OUT_OF_MEMORY:
+            return "out of memory";
+        case B64_ERROR_INVALID_PADDING:
+            return "invalid padding";
+        case B64_ERROR_NON_ZERO_TRAILING_BITS:
+            return "non-zero trailing bits";
+        default:
+            return "unknown error";
+    }
 }
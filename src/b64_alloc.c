@@ -0,0 +1,93 @@
+/**
+ * @file b64_alloc.c
+ * @brief Allocators of the encoded string/decoded byte array
+*/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "b64.h"
+
+/**
+ * @brief Alignment of the memory allocated from the arena
+*/
+#define ARENA_ALIGNMENT 16
+
+/**
+ * @brief Allocate memory by malloc()
+ *
+ * @param[in] size Byte size of the memory
+ * @param[in] context Unused
+ * @return Pointer to the memory
+*/
+static void* default_alloc(size_t size, void* context) {
+    (void)context;
+    return malloc(size);
+}
+
+/**
+ * @brief Free memory by free()
+ *
+ * @param[in] ptr Pointer to the memory
+ * @param[in] context Unused
+*/
+static void default_free(void* ptr, void* context) {
+    (void)context;
+    free(ptr);
+}
+
+const B64Allocator b64_default_allocator = { default_alloc, default_free, NULL };
+
+/**
+ * @brief Allocate memory from the arena
+ *
+ * @param[in] size Byte size of the memory
+ * @param[in,out] context Arena
+ * @return Pointer to the memory
+ * @retval NULL if the rest of the arena is not enough
+*/
+static void* arena_alloc(size_t size, void* context) {
+    B64Arena* arena = context;
+
+    const uintptr_t base = (uintptr_t)arena->buf;
+    const size_t offset = (size_t)(((base + arena->used + (ARENA_ALIGNMENT - 1)) & ~(uintptr_t)(ARENA_ALIGNMENT - 1)) - base);
+    if ((offset > arena->size) || (size > (arena->size - offset))) {
+        return NULL;
+    }
+
+    arena->last = offset;
+    arena->used = offset + size;
+
+    return &arena->buf[offset];
+}
+
+/**
+ * @brief Free memory allocated from the arena, only the last allocation is returned to the arena
+ *
+ * @param[in] ptr Pointer to the memory
+ * @param[in,out] context Arena
+*/
+static void arena_free(void* ptr, void* context) {
+    B64Arena* arena = context;
+
+    if ((ptr != NULL) && ((uint8_t*)ptr == &arena->buf[arena->last])) {
+        arena->used = arena->last;
+    }
+}
+
+void b64_arena_init(B64Arena* arena, void* buf, const size_t size) {
+    arena->buf = buf;
+    arena->size = size;
+    arena->used = 0;
+    arena->last = 0;
+}
+
+void b64_arena_reset(B64Arena* arena) {
+    arena->used = 0;
+    arena->last = 0;
+}
+
+B64Allocator b64_arena_allocator(B64Arena* arena) {
+    B64Allocator allocator = { arena_alloc, arena_free, arena };
+    return allocator;
+}
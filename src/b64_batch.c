@@ -0,0 +1,191 @@
+/**
+ * @file b64_batch.c
+ * @brief Base64 encoding/decoding of many inputs at once
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "b64.h"
+#include "b64_internal.h"
+
+/**
+ * @brief The number of 3-byte blocks of the small inputs encoded at once
+*/
+#define STAGING_BLOCKS 1024
+
+/**
+ * @brief Get the length of the encoded string without a null character
+ *
+ * @param[in] src_size Byte size of the input
+ * @param[in] use_padding Use padding
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @return Length of the encoded string, 0 for an empty input
+*/
+static inline size_t get_encoded_length(const size_t src_size, const bool use_padding, const size_t line_length) {
+    const size_t encoded_size = b64_get_encoded_size(src_size, use_padding, line_length);
+    return (encoded_size == 0) ? 0 : (encoded_size - 1);
+}
+
+size_t b64_get_batch_encoded_size(const B64Span* srcs, const size_t num_srcs, const bool use_padding, const size_t line_length) {
+    size_t total_length = 0;
+    for (size_t i = 0; i < num_srcs; ++i) {
+        total_length += get_encoded_length(srcs[i].size, use_padding, line_length);
+    }
+
+    return total_length;
+}
+
+/**
+ * @brief Encode an input into the buffer
+ *
+ * @param[out] dest Pointer to the output buffer
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet
+ * @param[in] use_padding Use padding
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @return Length of the encoded string
+*/
+static size_t encode_item(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    size_t column = 0;
+    size_t buf_index = b64_encode_blocks_in_lines(dest, src, src_size, alphabet, line_length, &column);
+
+    const size_t num_encoded_bytes = src_size / 3 * 3;
+    buf_index += b64_encode_last_block_in_lines(&dest[buf_index], &src[num_encoded_bytes], src_size - num_encoded_bytes, alphabet, use_padding, line_length, &column);
+
+    return buf_index;
+}
+
+B64Result b64_encode_batch(size_t* offsets, char* dest, const size_t dest_size, const B64Span* srcs, const size_t num_srcs, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    if ((offsets == NULL) || ((dest == NULL) && (dest_size > 0)) || ((srcs == NULL) && (num_srcs > 0)) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+    for (size_t i = 0; i < num_srcs; ++i) {
+        if ((srcs[i].data == NULL) && (srcs[i].size > 0)) {
+            return B64_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    // Check the total size once instead of each input
+    if (dest_size < b64_get_batch_encoded_size(srcs, num_srcs, use_padding, line_length)) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    size_t buf_index = 0;
+    offsets[0] = 0;
+
+    if (line_length > 0) {
+        for (size_t i = 0; i < num_srcs; ++i) {
+            if (srcs[i].size > 0) {
+                buf_index += encode_item(&dest[buf_index], srcs[i].data, srcs[i].size, alphabet, use_padding, line_length);
+            }
+            offsets[i + 1] = buf_index;
+        }
+        return B64_SUCCESS;
+    }
+
+    // Without linebreaks, the blocks of the small inputs are gathered
+    // and encoded at once to make SIMD instructions effective
+    uint8_t staged_bytes[STAGING_BLOCKS * 3];
+    char staged_chars[STAGING_BLOCKS * 4];
+
+    size_t i = 0;
+    while (i < num_srcs) {
+        size_t num_staged_bytes = 0;
+        size_t end = i;
+        for (; end < num_srcs; ++end) {
+            const size_t num_block_bytes = srcs[end].size / 3 * 3;
+            if ((sizeof(staged_bytes) - num_staged_bytes) < num_block_bytes) {
+                break;
+            }
+            if (num_block_bytes > 0) {
+                memcpy(&staged_bytes[num_staged_bytes], srcs[end].data, num_block_bytes);
+                num_staged_bytes += num_block_bytes;
+            }
+        }
+
+        // Encode the large input directly
+        if (end == i) {
+            buf_index += encode_item(&dest[buf_index], srcs[i].data, srcs[i].size, alphabet, use_padding, 0);
+            offsets[i + 1] = buf_index;
+            ++i;
+            continue;
+        }
+
+        size_t column = 0;
+        b64_encode_blocks_in_lines(staged_chars, staged_bytes, num_staged_bytes, alphabet, 0, &column);
+
+        // Scatter the encoded blocks and encode the last 1 or 2 bytes of each input
+        size_t num_staged_chars = 0;
+        for (; i < end; ++i) {
+            const uint8_t* src = srcs[i].data;
+            const size_t num_block_bytes = srcs[i].size / 3 * 3;
+            const size_t num_chars = num_block_bytes / 3 * 4;
+
+            memcpy(&dest[buf_index], &staged_chars[num_staged_chars], num_chars);
+            buf_index += num_chars;
+            num_staged_chars += num_chars;
+
+            if (srcs[i].size > num_block_bytes) {
+                buf_index += b64_encode_last_block_in_lines(&dest[buf_index], &src[num_block_bytes], srcs[i].size - num_block_bytes, alphabet, use_padding, 0, &column);
+            }
+            offsets[i + 1] = buf_index;
+        }
+    }
+
+    return B64_SUCCESS;
+}
+
+size_t b64_get_batch_decoded_size(const B64Span* srcs, const size_t num_srcs) {
+    size_t total_size = 0;
+    for (size_t i = 0; i < num_srcs; ++i) {
+        const size_t src_length = srcs[i].size;
+        total_size += (src_length / 4 * 3) + ((src_length % 4) * 3 / 4);
+    }
+
+    return total_size;
+}
+
+B64Result b64_decode_batch(size_t* offsets, void* dest, const size_t dest_size, const B64Span* srcs, const size_t num_srcs, const B64Alphabet* alphabet, const bool validate) {
+    if ((offsets == NULL) || ((dest == NULL) && (dest_size > 0)) || ((srcs == NULL) && (num_srcs > 0)) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t* output_bytes = dest;
+    size_t buf_index = 0;
+    offsets[0] = 0;
+    for (size_t i = 0; i < num_srcs; ++i) {
+        const char* src = srcs[i].data;
+        const size_t src_length = srcs[i].size;
+        if (src_length == 0) {
+            offsets[i + 1] = buf_index;
+            continue;
+        }
+        if (src == NULL) {
+            return B64_ERROR_INVALID_ARGUMENT;
+        }
+
+        B64DecodeState state;
+        b64_decode_init(&state, alphabet, validate);
+
+        size_t size;
+        B64Result result = b64_decode_chunk(&state, &size, &output_bytes[buf_index], dest_size - buf_index, src, src_length);
+        if (result != B64_SUCCESS) {
+            return result;
+        }
+        buf_index += size;
+
+        // Only padding or linebreaks fail as B64_ERROR_EMPTY_INPUT like b64_decode_into_n()
+        result = b64_decode_last_block(&state, &size, &output_bytes[buf_index], dest_size - buf_index);
+        if (result != B64_SUCCESS) {
+            return result;
+        }
+        buf_index += size;
+
+        offsets[i + 1] = buf_index;
+    }
+
+    return B64_SUCCESS;
+}
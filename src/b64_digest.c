@@ -0,0 +1,436 @@
+/**
+ * @file b64_digest.c
+ * @brief Base64 encoding/decoding with the checksum of the raw bytes in the same pass
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "b64.h"
+#include "b64_internal.h"
+
+/**
+ * @brief Byte size of the raw bytes encoded/decoded before updating the checksums,
+ * small enough to stay in L1 cache, multiple of 3 and the stripe of XXH64
+*/
+#define DIGEST_CHUNK_SIZE (3 * 1024)
+
+/**
+ * @brief CRC32C (Castagnoli, reflected polynomial 0x82f63b78) of each byte
+*/
+static const uint32_t crc32c_table[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c,
+    0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b,
+    0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c,
+    0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc,
+    0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a,
+    0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512,
+    0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad,
+    0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a,
+    0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf,
+    0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f,
+    0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927,
+    0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f,
+    0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e,
+    0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859,
+    0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e,
+    0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de,
+    0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c,
+    0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4,
+    0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b,
+    0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c,
+    0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5,
+    0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975,
+    0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d,
+    0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905,
+    0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8,
+    0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff,
+    0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8,
+    0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78,
+    0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee,
+    0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6,
+    0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69,
+    0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e,
+    0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+/**
+ * @brief Update CRC32C without inversion
+ *
+ * @param[in] crc CRC32C so far, not inverted
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+ * @return Updated CRC32C, not inverted
+*/
+static uint32_t update_crc32c(uint32_t crc, const uint8_t* data, const size_t size) {
+    // Use SSE4.2 if available
+    size_t i = b64_simd_crc32c(&crc, data, size);
+
+    for (; i < size; ++i) {
+        crc = crc32c_table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+uint32_t b64_crc32c(const uint32_t crc, const void* data, const size_t size) {
+    return ~update_crc32c(~crc, data, size);
+}
+
+/**
+ * @brief Primes of XXH64
+*/
+#define XXH_PRIME64_1 0x9e3779b185ebca87ULL
+#define XXH_PRIME64_2 0xc2b2ae3d27d4eb4fULL
+#define XXH_PRIME64_3 0x165667b19e3779f9ULL
+#define XXH_PRIME64_4 0x85ebca77c2b2ae63ULL
+#define XXH_PRIME64_5 0x27d4eb2f165667c5ULL
+
+/**
+ * @brief State of XXH64 updated by pieces of the data
+*/
+typedef struct Xxh64State_tag {
+    uint64_t accs[4]; // Accumulators of the 32-byte stripes
+    uint64_t total_size; // Byte size of the data so far
+    uint8_t buf[32]; // Bytes not filling a stripe
+    size_t buf_size; // Byte size of the bytes in buf
+    uint64_t seed; // Seed
+} Xxh64State;
+
+/**
+ * @brief Rotate 64-bit value to the left
+ *
+ * @param[in] x Value
+ * @param[in] r Bits to rotate, 1 to 63
+ * @return Rotated value
+*/
+static inline uint64_t rotl64(const uint64_t x, const int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * @brief Read 64-bit value in little endian
+ *
+ * @param[in] p Pointer to 8 bytes
+ * @return Value
+*/
+static inline uint64_t read64(const uint8_t* p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+        ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+/**
+ * @brief Read 32-bit value in little endian
+ *
+ * @param[in] p Pointer to 4 bytes
+ * @return Value
+*/
+static inline uint32_t read32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Accumulate 8 bytes of the input
+ *
+ * @param[in] acc Accumulator
+ * @param[in] input 8 bytes of the input
+ * @return Updated accumulator
+*/
+static inline uint64_t xxh64_round(uint64_t acc, const uint64_t input) {
+    acc += input * XXH_PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+/**
+ * @brief Merge an accumulator into the hash
+ *
+ * @param[in] acc Hash
+ * @param[in] value Accumulator
+ * @return Updated hash
+*/
+static inline uint64_t xxh64_merge_round(uint64_t acc, const uint64_t value) {
+    acc ^= xxh64_round(0, value);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+/**
+ * @brief Initialize the state of XXH64
+ *
+ * @param[out] state State
+ * @param[in] seed Seed
+*/
+static void xxh64_init(Xxh64State* state, const uint64_t seed) {
+    state->accs[0] = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    state->accs[1] = seed + XXH_PRIME64_2;
+    state->accs[2] = seed;
+    state->accs[3] = seed - XXH_PRIME64_1;
+    state->total_size = 0;
+    state->buf_size = 0;
+    state->seed = seed;
+}
+
+/**
+ * @brief Consume 32-byte stripes
+ *
+ * @param[in,out] accs Accumulators
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+ * @return Byte size of the consumed data, multiple of 32
+*/
+static size_t xxh64_consume_stripes(uint64_t accs[4], const uint8_t* data, const size_t size) {
+    uint64_t acc0 = accs[0];
+    uint64_t acc1 = accs[1];
+    uint64_t acc2 = accs[2];
+    uint64_t acc3 = accs[3];
+
+    size_t i = 0;
+    for (; (size - i) >= 32; i += 32) {
+        acc0 = xxh64_round(acc0, read64(&data[i]));
+        acc1 = xxh64_round(acc1, read64(&data[i + 8]));
+        acc2 = xxh64_round(acc2, read64(&data[i + 16]));
+        acc3 = xxh64_round(acc3, read64(&data[i + 24]));
+    }
+
+    accs[0] = acc0;
+    accs[1] = acc1;
+    accs[2] = acc2;
+    accs[3] = acc3;
+
+    return i;
+}
+
+/**
+ * @brief Update the state of XXH64 by a piece of the data
+ *
+ * @param[in,out] state State
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+*/
+static void xxh64_update(Xxh64State* state, const uint8_t* data, const size_t size) {
+    state->total_size += size;
+
+    size_t i = 0;
+    // Fill the stripe with the bytes remaining from the previous update
+    if (state->buf_size > 0) {
+        size_t num_to_fill = 32 - state->buf_size;
+        if (num_to_fill > size) {
+            num_to_fill = size;
+        }
+        memcpy(&state->buf[state->buf_size], data, num_to_fill);
+        state->buf_size += num_to_fill;
+        i = num_to_fill;
+
+        if (state->buf_size < 32) {
+            return;
+        }
+        xxh64_consume_stripes(state->accs, state->buf, 32);
+        state->buf_size = 0;
+    }
+
+    i += xxh64_consume_stripes(state->accs, &data[i], size - i);
+
+    memcpy(state->buf, &data[i], size - i);
+    state->buf_size = size - i;
+}
+
+/**
+ * @brief Get XXH64 of the data so far
+ *
+ * @param[in] state State
+ * @return XXH64
+*/
+static uint64_t xxh64_digest(const Xxh64State* state) {
+    uint64_t hash;
+    if (state->total_size >= 32) {
+        hash = rotl64(state->accs[0], 1) + rotl64(state->accs[1], 7) + rotl64(state->accs[2], 12) + rotl64(state->accs[3], 18);
+        for (int i = 0; i < 4; ++i) {
+            hash = xxh64_merge_round(hash, state->accs[i]);
+        }
+    } else {
+        hash = state->seed + XXH_PRIME64_5;
+    }
+    hash += state->total_size;
+
+    // Process the bytes not filling a stripe
+    const uint8_t* p = state->buf;
+    size_t size = state->buf_size;
+    for (; size >= 8; p += 8, size -= 8) {
+        hash ^= xxh64_round(0, read64(p));
+        hash = rotl64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+    if (size >= 4) {
+        hash ^= (uint64_t)read32(p) * XXH_PRIME64_1;
+        hash = rotl64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+        size -= 4;
+    }
+    for (; size > 0; ++p, --size) {
+        hash ^= (uint64_t)(*p) * XXH_PRIME64_5;
+        hash = rotl64(hash, 11) * XXH_PRIME64_1;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+uint64_t b64_xxh64(const void* data, const size_t size, const uint64_t seed) {
+    Xxh64State state;
+    xxh64_init(&state, seed);
+    xxh64_update(&state, data, size);
+
+    return xxh64_digest(&state);
+}
+
+/**
+ * @brief Checksums computed by pieces of the raw bytes
+*/
+typedef struct DigestState_tag {
+    unsigned int types; // Types of the checksums, B64_DIGEST_***
+    uint32_t crc; // CRC32C, not inverted
+    Xxh64State xxh64; // State of XXH64
+} DigestState;
+
+/**
+ * @brief Initialize the checksums
+ *
+ * @param[out] state State of the checksums
+ * @param[in] types Types of the checksums
+*/
+static void digest_init(DigestState* state, const unsigned int types) {
+    state->types = types;
+    state->crc = ~(uint32_t)0;
+    xxh64_init(&state->xxh64, 0);
+}
+
+/**
+ * @brief Update the checksums by a piece of the raw bytes
+ *
+ * @param[in,out] state State of the checksums
+ * @param[in] data Pointer to the raw bytes
+ * @param[in] size Byte size of the raw bytes
+*/
+static void digest_update(DigestState* state, const uint8_t* data, const size_t size) {
+    if ((state->types & B64_DIGEST_CRC32C) != 0) {
+        state->crc = update_crc32c(state->crc, data, size);
+    }
+    if ((state->types & B64_DIGEST_XXH64) != 0) {
+        xxh64_update(&state->xxh64, data, size);
+    }
+}
+
+/**
+ * @brief Write the checksums
+ *
+ * @param[in] state State of the checksums
+ * @param[out] digest Checksums, not computed ones are 0
+*/
+static void digest_final(const DigestState* state, B64Digest* digest) {
+    digest->crc32c = ((state->types & B64_DIGEST_CRC32C) != 0) ? ~state->crc : 0;
+    digest->xxh64 = ((state->types & B64_DIGEST_XXH64) != 0) ? xxh64_digest(&state->xxh64) : 0;
+}
+
+B64Result b64_encode_into_with_digest(size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, const unsigned int digest_types, B64Digest* digest) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL) || (digest == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t encoded_byte_size = b64_get_encoded_size(src_size, use_padding, line_length);
+    if (encoded_byte_size == 0) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+    if (dest_size < encoded_byte_size) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    DigestState state;
+    digest_init(&state, digest_types);
+
+    // Encode by chunks, then the checksums are updated while the chunk is on the cache
+    const uint8_t* input_bytes = src;
+    const size_t num_block_bytes = src_size / 3 * 3;
+    size_t buf_index = 0;
+    size_t column = 0;
+    for (size_t i = 0; i < num_block_bytes; i += DIGEST_CHUNK_SIZE) {
+        const size_t size = ((num_block_bytes - i) < DIGEST_CHUNK_SIZE) ? (num_block_bytes - i) : DIGEST_CHUNK_SIZE;
+        buf_index += b64_encode_blocks_in_lines(&dest[buf_index], &input_bytes[i], size, alphabet, line_length, &column);
+        digest_update(&state, &input_bytes[i], size);
+    }
+
+    // Encode the remaining 1 or 2 bytes
+    buf_index += b64_encode_last_block_in_lines(&dest[buf_index], &input_bytes[num_block_bytes], src_size - num_block_bytes, alphabet, use_padding, line_length, &column);
+    digest_update(&state, &input_bytes[num_block_bytes], src_size - num_block_bytes);
+
+    // Terminate encoded string
+    dest[buf_index] = '\0';
+
+    *length = buf_index;
+    digest_final(&state, digest);
+
+    return B64_SUCCESS;
+}
+
+B64Result b64_decode_into_with_digest(size_t* size, void* dest, const size_t dest_size, const char* src, const B64Alphabet* alphabet, const bool validate, const unsigned int digest_types, B64Digest* digest) {
+    if (src == NULL) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    return b64_decode_into_with_digest_n(size, dest, dest_size, src, strlen(src), alphabet, validate, digest_types, digest);
+}
+
+B64Result b64_decode_into_with_digest_n(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate, const unsigned int digest_types, B64Digest* digest) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL) || (digest == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    DigestState state;
+    digest_init(&state, digest_types);
+
+    B64DecodeState decode_state;
+    b64_decode_init(&decode_state, alphabet, validate);
+
+    // Decode by chunks, then the checksums are updated while the decoded bytes are on the cache
+    uint8_t* output_bytes = dest;
+    const size_t chunk_length = DIGEST_CHUNK_SIZE / 3 * 4;
+    size_t buf_index = 0;
+    for (size_t i = 0; i < src_length; i += chunk_length) {
+        const size_t length = ((src_length - i) < chunk_length) ? (src_length - i) : chunk_length;
+        size_t decoded_size;
+        B64Result result = b64_decode_chunk(&decode_state, &decoded_size, &output_bytes[buf_index], dest_size - buf_index, &src[i], length);
+        if (result != B64_SUCCESS) {
+            return result;
+        }
+        digest_update(&state, &output_bytes[buf_index], decoded_size);
+        buf_index += decoded_size;
+    }
+
+    size_t decoded_size;
+    B64Result result = b64_decode_last_block(&decode_state, &decoded_size, &output_bytes[buf_index], dest_size - buf_index);
+    if (result != B64_SUCCESS) {
+        return result;
+    }
+    digest_update(&state, &output_bytes[buf_index], decoded_size);
+    buf_index += decoded_size;
+
+    *size = buf_index;
+    digest_final(&state, digest);
+
+    return B64_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file b64_internal.h
+ * @brief Internal functions shared among the source files of the library
+*/
+#ifndef B64_INTERNAL_H
+#define B64_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "b64.h"
+
+/**
+ * @brief Padding
+*/
+#define PADDING '='
+
+/**
+ * @brief Carriage return
+*/
+#define CHAR_CR '\x0d'
+/**
+ * @brief Line feed
+*/
+#define CHAR_LF '\x0a'
+/**
+ * @brief Null character
+*/
+#define CHAR_NULL '\0'
+
+/**
+ * @brief Value in the decoding tables for characters out of the alphabet
+*/
+#define INVALID_VALUE 0xff
+
+/**
+ * @brief Bit set in the shifted decoding tables for characters out of the alphabet
+*/
+#define SHIFTED_INVALID_VALUE 0x01000000u
+
+/**
+ * @brief Load 6 bytes as a big-endian 48-bit value
+ *
+ * @param[in] src Pointer to the bytes
+ * @return 48-bit value, combined into a load and a byte swap by compilers
+*/
+static inline uint64_t load_be48(const uint8_t* src) {
+    return ((uint64_t)src[0] << 40) | ((uint64_t)src[1] << 32) | ((uint64_t)src[2] << 24) |
+        ((uint64_t)src[3] << 16) | ((uint64_t)src[4] << 8) | (uint64_t)src[5];
+}
+
+/**
+ * @brief Encode all 3-byte blocks in the input, inserting CRLF every line length
+ *
+ * CRLF is inserted before a character exceeding the line length,
+ * so it is never written at the end of the output.
+ *
+ * @param[out] dest Pointer to the Base64 encoded characters, without a null character
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input, the last (src_size % 3) bytes are not encoded
+ * @param[in] alphabet Alphabet
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @param[in,out] column The number of characters in the current line
+ * @return Length of the written string
+*/
+size_t b64_encode_blocks_in_lines(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const size_t line_length, size_t* column);
+
+/**
+ * @brief Encode the last 1 or 2 bytes of the input, inserting CRLF every line length
+ *
+ * @param[out] dest Pointer to the Base64 encoded characters, without a null character
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input, 0 to 2
+ * @param[in] alphabet Alphabet
+ * @param[in] use_padding Use padding
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @param[in,out] column The number of characters in the current line
+ * @return Length of the written string
+*/
+size_t b64_encode_last_block_in_lines(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length, size_t* column);
+
+/**
+ * @brief Decode a chunk of the input, keeping the characters not filling a block in the state
+ *
+ * Validation, skipping CRLF (or non encoding characters if not validated)
+ * and decoding are done in a single pass over the input.
+ * dest may be the same as src to decode in place.
+ *
+ * @param[in,out] state State of the decoding
+ * @param[out] size Byte size of the decoded byte array
+ * @param[out] dest Pointer to the buffer
+ * @param[in] dest_size Byte size of the buffer, checked before writing each block
+ * @param[in] src Pointer to the input Base64 string
+ * @param[in] src_length Length of the input string
+ * @return Result of the decoding
+*/
+B64Result b64_decode_chunk(B64DecodeState* state, size_t* size, uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length);
+
+/**
+ * @brief Decode the characters remaining in the state at the end of the input
+ *
+ * @param[in,out] state State of the decoding
+ * @param[out] size Byte size of the decoded byte array, 0 to 2
+ * @param[out] dest Pointer to the buffer
+ * @param[in] dest_size Byte size of the buffer
+ * @return Result of the decoding
+*/
+B64Result b64_decode_last_block(B64DecodeState* state, size_t* size, uint8_t* dest, const size_t dest_size);
+
+/**
+ * @brief Encode an input of up to B64_SMALL_MAX_SIZE bytes without linebreaks
+ *
+ * Unrolled routines specialized for the common fixed sizes are selected by the size.
+ *
+ * @param[out] dest Pointer to the buffer, which has the size by b64_get_encoded_size()
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input, 1 to B64_SMALL_MAX_SIZE
+ * @param[in] alphabet Alphabet
+ * @param[in] use_padding Use padding
+ * @return Length of the null-terminated encoded string
+*/
+size_t b64_encode_small_input(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding);
+
+/**
+ * @brief Decode an input of up to B64_SMALL_MAX_LENGTH characters without linebreaks
+ *
+ * All characters except up to 2 trailing paddings must be encoding characters.
+ * The buffer may be written even if the decoding fails.
+ *
+ * @param[out] size Byte size of the decoded byte array
+ * @param[out] dest Pointer to the buffer
+ * @param[in] dest_size Byte size of the buffer
+ * @param[in] src Pointer to the input Base64 string
+ * @param[in] src_length Length of the input string, up to B64_SMALL_MAX_LENGTH
+ * @param[in] alphabet Alphabet
+ * @return Result of the decoding
+*/
+B64Result b64_decode_small_input(size_t* size, uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet);
+
+/**
+ * @brief Encode the 3-byte blocks at the beginning of the input by SIMD instructions
+ *
+ * An instruction set is selected from AVX2 and SSSE3 by the running CPU.
+ * The rest of the input is left to the scalar encoding.
+ *
+ * @param[out] dest Pointer to the Base64 encoded characters, without linebreaks and a null character
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet
+ * @return Byte size of the encoded input, multiple of 3
+ * @retval 0 if SIMD instructions are not available
+*/
+size_t b64_simd_encode_blocks(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet);
+
+/**
+ * @brief Decode the 4-character blocks at the beginning of the input by SIMD instructions
+ *
+ * An instruction set is selected from AVX2 and SSSE3 by the running CPU.
+ * Decoding stops at the first block including a character out of the alphabet
+ * (padding, linebreak or invalid character), which is left to the scalar decoding.
+ *
+ * @param[out] dest Pointer to the decoded bytes
+ * @param[in] dest_size Byte size of the output buffer
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @return Length of the decoded input, multiple of 4
+ * @retval 0 if SIMD instructions are not available
+*/
+size_t b64_simd_decode_blocks(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet);
+
+/**
+ * @brief Count the encoding characters at the beginning of the input by SIMD instructions
+ *
+ * An instruction set is selected from AVX2 and SSSE3 by the running CPU.
+ * Counting stops at the first block including the padding, which is left to the scalar counting.
+ *
+ * @param[in,out] num_chars The number of the encoding characters, incremented by the counted ones
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @return Length of the counted input, multiple of 16
+ * @retval 0 if SIMD instructions are not available
+*/
+size_t b64_simd_count_chars(size_t* num_chars, const char* src, const size_t src_length, const B64Alphabet* alphabet);
+
+/**
+ * @brief Count the encoding characters before the first padding
+ *
+ * The leading blocks without the padding are counted by SIMD instructions if available.
+ *
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] alphabet Alphabet
+ * @param[out] padding_found Padding is found in the input
+ * @return The number of the encoding characters before the first padding
+*/
+size_t b64_count_encoding_chars(const char* src, const size_t src_length, const B64Alphabet* alphabet, bool* padding_found);
+
+/**
+ * @brief Update CRC32C by the CRC32 instruction of SSE4.2
+ *
+ * @param[in,out] crc CRC32C so far, not inverted
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+ * @return Byte size of the processed data, all of the data
+ * @retval 0 if SSE4.2 is not available
+*/
+size_t b64_simd_crc32c(uint32_t* crc, const uint8_t* data, const size_t size);
+
+#ifdef B64_STATS
+/**
+ * @brief Get the current time for measuring the latency
+ *
+ * @return Monotonic time in nanoseconds
+*/
+uint64_t b64_stats_now(void);
+
+/**
+ * @brief Record a call of the entry point in the statistics of the calling thread
+ *
+ * @param[in] entry Entry point
+ * @param[in] input_size Byte size (length) of the input
+ * @param[in] output_size Byte size (length) of the output, ignored if failed
+ * @param[in] result Result of the call
+ * @param[in] start Time when the call started, by b64_stats_now()
+*/
+void b64_stats_record(const B64StatsEntry entry, const size_t input_size, const size_t output_size, const B64Result result, const uint64_t start);
+#endif
+
+#endif // B64_INTERNAL_H
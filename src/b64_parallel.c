@@ -0,0 +1,481 @@
+/**
+ * @file b64_parallel.c
+ * @brief Multi-threaded Base64 encoding/decoding
+*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "b64.h"
+#include "b64_internal.h"
+
+// Minimum byte size of the input processed by a task
+#define MIN_CHUNK_SIZE (64 * 1024)
+
+// The number of tasks per thread, for load balancing
+#define NUM_TASKS_PER_THREAD 4
+
+/**
+ * @brief Function executing a task
+*/
+typedef void (*TaskFunction)(void* task);
+
+struct B64ThreadPool_tag {
+    pthread_t* workers; // Worker threads
+    size_t num_workers; // The number of the worker threads
+    pthread_mutex_t run_mutex; // Serialize the runs from multiple threads
+    pthread_mutex_t mutex; // Protect the members below
+    pthread_cond_t task_cond; // Signaled when the tasks are given or the pool is destroyed
+    pthread_cond_t done_cond; // Signaled when all tasks are done
+    TaskFunction task_function; // Function executing the tasks
+    uint8_t* tasks; // Array of the tasks
+    size_t task_size; // Byte size of a task
+    size_t num_tasks; // The number of the tasks
+    size_t next_task; // Index of the next task to be taken
+    size_t num_done_tasks; // The number of the finished tasks
+    bool shutdown; // The pool is being destroyed
+};
+
+/**
+ * @brief Take and execute the tasks until all tasks are taken
+ *
+ * @param[in,out] pool Thread pool, the mutex must be locked
+*/
+static void execute_tasks(B64ThreadPool* pool) {
+    while (pool->next_task < pool->num_tasks) {
+        void* task = &pool->tasks[pool->next_task * pool->task_size];
+        ++pool->next_task;
+
+        pthread_mutex_unlock(&pool->mutex);
+        pool->task_function(task);
+        pthread_mutex_lock(&pool->mutex);
+
+        ++pool->num_done_tasks;
+        if (pool->num_done_tasks == pool->num_tasks) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+}
+
+/**
+ * @brief Main function of the worker threads
+ *
+ * @param[in,out] arg Thread pool
+ * @return NULL
+*/
+static void* worker_main(void* arg) {
+    B64ThreadPool* pool = arg;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (!pool->shutdown) {
+        execute_tasks(pool);
+        pthread_cond_wait(&pool->task_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Execute the tasks on the thread pool and wait for all of them
+ *
+ * The calling thread also executes the tasks.
+ *
+ * @param[in,out] pool Thread pool, if NULL, the tasks are executed sequentially
+ * @param[in] task_function Function executing a task
+ * @param[in,out] tasks Array of the tasks
+ * @param[in] task_size Byte size of a task
+ * @param[in] num_tasks The number of the tasks
+*/
+static void run_tasks(B64ThreadPool* pool, const TaskFunction task_function, void* tasks, const size_t task_size, const size_t num_tasks) {
+    if ((pool == NULL) || (pool->num_workers == 0) || (num_tasks <= 1)) {
+        for (size_t i = 0; i < num_tasks; ++i) {
+            task_function(&((uint8_t*)tasks)[i * task_size]);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->run_mutex);
+    pthread_mutex_lock(&pool->mutex);
+
+    pool->task_function = task_function;
+    pool->tasks = tasks;
+    pool->task_size = task_size;
+    pool->num_tasks = num_tasks;
+    pool->next_task = 0;
+    pool->num_done_tasks = 0;
+    pthread_cond_broadcast(&pool->task_cond);
+
+    execute_tasks(pool);
+    while (pool->num_done_tasks < pool->num_tasks) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+
+    pool->tasks = NULL;
+    pool->num_tasks = 0;
+    pool->next_task = 0;
+
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->run_mutex);
+}
+
+/**
+ * @brief Get the number of the tasks to split the input into
+ *
+ * @param[in] pool Thread pool
+ * @param[in] src_size Byte size of the input
+ * @return The number of the tasks, at least 1
+*/
+static size_t get_num_tasks(const B64ThreadPool* pool, const size_t src_size) {
+    if (pool == NULL) {
+        return 1;
+    }
+
+    size_t num_tasks = (pool->num_workers + 1) * NUM_TASKS_PER_THREAD;
+    if ((src_size / MIN_CHUNK_SIZE) < num_tasks) {
+        num_tasks = src_size / MIN_CHUNK_SIZE;
+    }
+
+    return (num_tasks == 0) ? 1 : num_tasks;
+}
+
+B64ThreadPool* b64_thread_pool_create(const size_t num_threads) {
+    size_t num_all_threads = num_threads;
+    if (num_all_threads == 0) {
+        long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+        num_all_threads = (num_processors > 0) ? (size_t)num_processors : 1;
+    }
+
+    B64ThreadPool* pool = malloc(sizeof(B64ThreadPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    // The calling thread works as one of the threads
+    pool->num_workers = 0;
+    pool->workers = malloc(sizeof(pthread_t) * num_all_threads);
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->run_mutex, NULL);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->task_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+    pool->task_function = NULL;
+    pool->tasks = NULL;
+    pool->task_size = 0;
+    pool->num_tasks = 0;
+    pool->next_task = 0;
+    pool->num_done_tasks = 0;
+    pool->shutdown = false;
+
+    for (size_t i = 0; i < (num_all_threads - 1); ++i) {
+        if (pthread_create(&pool->workers[i], NULL, worker_main, pool) != 0) {
+            b64_thread_pool_destroy(pool);
+            return NULL;
+        }
+        ++pool->num_workers;
+    }
+
+    return pool;
+}
+
+void b64_thread_pool_destroy(B64ThreadPool* pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->task_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (size_t i = 0; i < pool->num_workers; ++i) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->task_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_mutex_destroy(&pool->run_mutex);
+
+    free(pool->workers);
+    free(pool);
+}
+
+size_t b64_thread_pool_get_num_threads(const B64ThreadPool* pool) {
+    return (pool == NULL) ? 1 : (pool->num_workers + 1);
+}
+
+/**
+ * @brief Task of the parallel encoding
+*/
+typedef struct EncodeTask_tag {
+    char* dest; // Pointer to the output, at the offset of the chunk
+    const uint8_t* src; // Pointer to the input, at the offset of the chunk
+    size_t src_size; // Byte size of the chunk, a multiple of 3
+    const B64Alphabet* alphabet; // Alphabet
+    size_t line_length; // Length to insert linebreak
+    size_t column; // The number of characters in the current line
+} EncodeTask;
+
+/**
+ * @brief Encode a chunk of the input
+ *
+ * @param[in,out] task Task of the parallel encoding
+*/
+static void encode_task(void* task) {
+    EncodeTask* t = task;
+    b64_encode_blocks_in_lines(t->dest, t->src, t->src_size, t->alphabet, t->line_length, &t->column);
+}
+
+/**
+ * @brief Get the length of the encoded characters starting at a line, without a trailing CRLF
+ *
+ * @param[in] num_chars The number of encoded characters
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @return Length of the characters including CRLF
+*/
+static inline size_t get_length_in_lines(const size_t num_chars, const size_t line_length) {
+    if ((line_length == 0) || (num_chars == 0)) {
+        return num_chars;
+    }
+
+    return num_chars + ((num_chars - 1) / line_length) * 2;
+}
+
+B64Result b64_parallel_encode_into(B64ThreadPool* pool, size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t encoded_byte_size = b64_get_encoded_size(src_size, use_padding, line_length);
+    if (encoded_byte_size == 0) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+    if (dest_size < encoded_byte_size) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Split the input at the multiples of 4 lines (or 1 block without linebreaks),
+    // so every chunk except the first starts by CRLF at the beginning of a line
+    const size_t unit_size = (line_length == 0) ? 3 : (3 * line_length);
+    const size_t num_units = src_size / unit_size;
+
+    size_t num_tasks = get_num_tasks(pool, src_size);
+    if (num_tasks > num_units) {
+        num_tasks = (num_units == 0) ? 1 : num_units;
+    }
+
+    EncodeTask* tasks = malloc(sizeof(EncodeTask) * num_tasks);
+    if (tasks == NULL) {
+        return b64_encode_into(length, dest, dest_size, src, src_size, alphabet, use_padding, line_length);
+    }
+
+    const uint8_t* input_bytes = src;
+    const size_t num_block_bytes = src_size / 3 * 3;
+    const size_t num_units_per_task = (num_units + num_tasks - 1) / num_tasks;
+
+    for (size_t i = 0; i < num_tasks; ++i) {
+        size_t offset = i * num_units_per_task * unit_size;
+        if (offset > num_block_bytes) {
+            offset = num_block_bytes;
+        }
+        size_t end = (i == (num_tasks - 1)) ? num_block_bytes : ((i + 1) * num_units_per_task * unit_size);
+        if (end > num_block_bytes) {
+            end = num_block_bytes;
+        }
+
+        // Output offset is computed from the number of the characters before the chunk
+        EncodeTask* task = &tasks[i];
+        task->dest = &dest[get_length_in_lines(offset / 3 * 4, line_length)];
+        task->src = &input_bytes[offset];
+        task->src_size = end - offset;
+        task->alphabet = alphabet;
+        task->line_length = line_length;
+        task->column = (offset == 0) ? 0 : line_length;
+    }
+
+    run_tasks(pool, encode_task, tasks, sizeof(EncodeTask), num_tasks);
+
+    size_t column = 0;
+    for (size_t i = 0; i < num_tasks; ++i) {
+        if (tasks[i].src_size > 0) {
+            column = tasks[i].column;
+        }
+    }
+    free(tasks);
+
+    // Encode the remaining 1 or 2 bytes
+    size_t buf_index = get_length_in_lines(num_block_bytes / 3 * 4, line_length);
+    buf_index += b64_encode_last_block_in_lines(&dest[buf_index], &input_bytes[num_block_bytes], src_size - num_block_bytes, alphabet, use_padding, line_length, &column);
+
+    // Terminate encoded string
+    dest[buf_index] = '\0';
+
+    *length = buf_index;
+
+    return B64_SUCCESS;
+}
+
+/**
+ * @brief Task of the parallel decoding
+*/
+typedef struct DecodeTask_tag {
+    const char* src; // Pointer to the input, at the offset of the chunk
+    size_t src_length; // Length of the chunk
+    size_t num_values; // The number of the encoding characters before padding
+    bool padding_found; // Padding is found in the chunk
+    uint8_t* dest; // Pointer to the output, at the offset of the chunk
+    size_t dest_size; // Byte size of the output of the chunk
+    B64DecodeState state; // State of the decoding
+    size_t size; // Byte size of the decoded byte array
+    B64Result result; // Result of the decoding
+} DecodeTask;
+
+/**
+ * @brief Count the encoding characters in a chunk of the input
+ *
+ * @param[in,out] task Task of the parallel decoding
+*/
+static void count_task(void* task) {
+    DecodeTask* t = task;
+
+    // Characters after padding are not decoded
+    t->num_values = b64_count_encoding_chars(t->src, t->src_length, t->state.alphabet, &t->padding_found);
+}
+
+/**
+ * @brief Decode a chunk of the input
+ *
+ * @param[in,out] task Task of the parallel decoding
+*/
+static void decode_task(void* task) {
+    DecodeTask* t = task;
+    t->result = b64_decode_chunk(&t->state, &t->size, t->dest, t->dest_size, t->src, t->src_length);
+}
+
+B64Result b64_parallel_decode_into(B64ThreadPool* pool, size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet, const bool validate) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    const size_t num_tasks = get_num_tasks(pool, src_length);
+    if (num_tasks == 1) {
+        return b64_decode_into_n(size, dest, dest_size, src, src_length, alphabet, validate);
+    }
+
+    DecodeTask* tasks = malloc(sizeof(DecodeTask) * num_tasks);
+    if (tasks == NULL) {
+        return b64_decode_into_n(size, dest, dest_size, src, src_length, alphabet, validate);
+    }
+
+    // Count the encoding characters of each chunk in parallel
+    const size_t chunk_length = src_length / num_tasks;
+    for (size_t i = 0; i < num_tasks; ++i) {
+        DecodeTask* task = &tasks[i];
+        task->src = &src[i * chunk_length];
+        task->src_length = (i == (num_tasks - 1)) ? (src_length - i * chunk_length) : chunk_length;
+        b64_decode_init(&task->state, alphabet, validate);
+    }
+
+    run_tasks(pool, count_task, tasks, sizeof(DecodeTask), num_tasks);
+
+    // Move each boundary forward to the beginning of a 4-character block,
+    // then the output offset of each chunk is determined by the characters before it
+    const uint8_t* decoding_table = alphabet->decoding_table;
+    const char* end = &src[src_length];
+    const char* begin = src;
+    size_t num_values = 0;
+    size_t begin_num_values = 0;
+    bool padding_found = false;
+    for (size_t i = 0; i < num_tasks; ++i) {
+        DecodeTask* task = &tasks[i];
+        const char* chunk_begin = task->src;
+
+        if (chunk_begin > begin) {
+            begin = chunk_begin;
+            begin_num_values = num_values;
+            while (!padding_found && ((begin_num_values % 4) != 0) && (begin < end) && (*begin != PADDING)) {
+                begin_num_values += (decoding_table[(uint8_t)*begin] != INVALID_VALUE);
+                ++begin;
+            }
+        }
+
+        // The rest after padding is only validated
+        task->state.padding_found = padding_found;
+        if (!padding_found) {
+            num_values += task->num_values;
+            padding_found = task->padding_found;
+        }
+
+        task->src = begin;
+        task->num_values = begin_num_values;
+    }
+
+    // Decoded size is checked in advance as the chunks are written in parallel
+    const size_t num_remaining_values = num_values % 4;
+    const size_t decoded_size = num_values / 4 * 3 + ((num_remaining_values > 1) ? (num_remaining_values - 1) : 0);
+    if (dest_size < decoded_size) {
+        // Decoded in the calling thread up to the end of the buffer, to return the same error
+        // as b64_decode_into_n() (e.g. B64_ERROR_INVALID_CHAR before the buffer is filled)
+        free(tasks);
+        return b64_decode_into_n(size, dest, dest_size, src, src_length, alphabet, validate);
+    }
+
+    uint8_t* output_bytes = dest;
+    for (size_t i = 0; i < num_tasks; ++i) {
+        DecodeTask* task = &tasks[i];
+        const char* chunk_end = (i == (num_tasks - 1)) ? end : tasks[i + 1].src;
+        const size_t chunk_num_values = ((i == (num_tasks - 1)) ? num_values : tasks[i + 1].num_values) - task->num_values;
+
+        task->src_length = (size_t)(chunk_end - task->src);
+        task->dest = &output_bytes[task->num_values / 4 * 3];
+        task->dest_size = chunk_num_values / 4 * 3;
+    }
+
+    // Decode the chunks in parallel
+    run_tasks(pool, decode_task, tasks, sizeof(DecodeTask), num_tasks);
+
+    B64Result result = B64_SUCCESS;
+    B64DecodeState last_state;
+    b64_decode_init(&last_state, alphabet, validate);
+    size_t total_size = 0;
+    for (size_t i = 0; i < num_tasks; ++i) {
+        if (tasks[i].result != B64_SUCCESS) {
+            result = tasks[i].result;
+            break;
+        }
+        total_size += tasks[i].size;
+
+        // Only the chunk at the end of the encoding characters keeps the remaining characters
+        if (tasks[i].state.num_decoded_values > 0) {
+            last_state = tasks[i].state;
+        }
+    }
+    free(tasks);
+
+    if (result != B64_SUCCESS) {
+        return result;
+    }
+
+    // Decode the remaining characters
+    size_t last_size;
+    last_state.decoded_size = total_size;
+    result = b64_decode_last_block(&last_state, &last_size, &output_bytes[total_size], dest_size - total_size);
+    if (result != B64_SUCCESS) {
+        return result;
+    }
+
+    *size = total_size + last_size;
+
+    return B64_SUCCESS;
+}
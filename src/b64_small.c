@@ -0,0 +1,237 @@
+/**
+ * @file b64_small.c
+ * @brief Base64 encoding/decoding of small inputs, specialized for the common fixed sizes
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "b64.h"
+#include "b64_internal.h"
+
+#if defined(__GNUC__)
+/**
+ * @brief Inline the function into the callers, each of which has a constant input size
+*/
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+/**
+ * @brief Unroll the following loop completely for a constant trip count
+*/
+#define UNROLL _Pragma("GCC unroll 16")
+#else
+#define ALWAYS_INLINE inline
+#define UNROLL
+#endif
+
+/**
+ * @brief Load 8 bytes as a big-endian 64-bit value
+ *
+ * @param[in] src Pointer to the bytes
+ * @return 64-bit value, combined into a load and a byte swap by compilers
+*/
+static inline uint64_t load_be64(const uint8_t* src) {
+    return ((uint64_t)src[0] << 56) | ((uint64_t)src[1] << 48) | ((uint64_t)src[2] << 40) | ((uint64_t)src[3] << 32) |
+        ((uint64_t)src[4] << 24) | ((uint64_t)src[5] << 16) | ((uint64_t)src[6] << 8) | (uint64_t)src[7];
+}
+
+/**
+ * @brief Encode a small input without linebreaks
+ *
+ * It is inlined into a caller with a constant src_size,
+ * so that the loops are unrolled and the tail is selected at compile time.
+ *
+ * @param[out] dest Pointer to the buffer, which has the size by b64_get_encoded_size()
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] alphabet Alphabet
+ * @param[in] use_padding Use padding
+ * @return Length of the encoded string
+*/
+static ALWAYS_INLINE size_t encode_fixed(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding) {
+    const char (*pair_table)[2] = alphabet->encoding_pair_table;
+
+    // 2 blocks (48 bits) into 8 characters by the 12-bit table,
+    // loaded with the next 2 bytes unless they are out of the input
+    size_t i = 0;
+    size_t j = 0;
+    UNROLL
+    for (; (src_size - i) >= 6; i += 6, j += 8) {
+        const uint64_t bits = ((src_size - i) >= 8) ? (load_be64(&src[i]) >> 16) : load_be48(&src[i]);
+        memcpy(&dest[j], pair_table[(bits >> 36) & 0xfff], 2);
+        memcpy(&dest[j + 2], pair_table[(bits >> 24) & 0xfff], 2);
+        memcpy(&dest[j + 4], pair_table[(bits >> 12) & 0xfff], 2);
+        memcpy(&dest[j + 6], pair_table[bits & 0xfff], 2);
+    }
+
+    // A remaining block
+    if ((src_size - i) >= 3) {
+        const uint32_t bits = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1] << 8) | src[i + 2];
+        memcpy(&dest[j], pair_table[bits >> 12], 2);
+        memcpy(&dest[j + 2], pair_table[bits & 0xfff], 2);
+        i += 3;
+        j += 4;
+    }
+
+    // The last 1 or 2 bytes
+    if ((src_size - i) == 2) {
+        const uint32_t bits = ((uint32_t)src[i] << 10) | ((uint32_t)src[i + 1] << 2);
+        memcpy(&dest[j], pair_table[bits >> 6], 2);
+        dest[j + 2] = alphabet->encoding_table[bits & 0x3f];
+        j += 3;
+        if (use_padding) {
+            dest[j++] = PADDING;
+        }
+    } else if ((src_size - i) == 1) {
+        memcpy(&dest[j], pair_table[(uint32_t)src[i] << 4], 2);
+        j += 2;
+        if (use_padding) {
+            dest[j++] = PADDING;
+            dest[j++] = PADDING;
+        }
+    }
+
+    dest[j] = CHAR_NULL;
+
+    return j;
+}
+
+size_t b64_encode_small_input(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding) {
+    // UUIDs, SHA-1/SHA-256 digests and keys (SHA-512 digests)
+    switch (src_size) {
+        case 16:
+            return encode_fixed(dest, src, 16, alphabet, use_padding);
+        case 20:
+            return encode_fixed(dest, src, 20, alphabet, use_padding);
+        case 32:
+            return encode_fixed(dest, src, 32, alphabet, use_padding);
+        case 64:
+            return encode_fixed(dest, src, 64, alphabet, use_padding);
+        default:
+            return encode_fixed(dest, src, src_size, alphabet, use_padding);
+    }
+}
+
+/**
+ * @brief Decode the encoding characters of a small input without linebreaks and the padding
+ *
+ * It is inlined into a caller with a constant num_chars like encode_fixed().
+ * Characters out of the alphabet are checked once after all blocks are decoded.
+ *
+ * @param[out] dest Pointer to the buffer, which has the decoded size
+ * @param[in] src Pointer to the encoding characters
+ * @param[in] num_chars The number of the encoding characters, not (4n + 1)
+ * @param[in] alphabet Alphabet
+ * @return true if all characters are in the alphabet
+*/
+static ALWAYS_INLINE bool decode_fixed(uint8_t* dest, const uint8_t* src, const size_t num_chars, const B64Alphabet* alphabet) {
+    const uint32_t (*tables)[256] = alphabet->shifted_decoding_tables;
+
+    uint32_t invalid = 0;
+    size_t i = 0;
+    size_t j = 0;
+    UNROLL
+    for (; (num_chars - i) >= 4; i += 4, j += 3) {
+        const uint32_t block = tables[0][src[i]] | tables[1][src[i + 1]] | tables[2][src[i + 2]] | tables[3][src[i + 3]];
+        invalid |= block;
+        dest[j] = (uint8_t)(block >> 16);
+        dest[j + 1] = (uint8_t)(block >> 8);
+        dest[j + 2] = (uint8_t)block;
+    }
+
+    if ((num_chars - i) == 3) {
+        const uint32_t block = tables[0][src[i]] | tables[1][src[i + 1]] | tables[2][src[i + 2]];
+        invalid |= block;
+        dest[j] = (uint8_t)(block >> 16);
+        dest[j + 1] = (uint8_t)(block >> 8);
+    } else if ((num_chars - i) == 2) {
+        const uint32_t block = tables[0][src[i]] | tables[1][src[i + 1]];
+        invalid |= block;
+        dest[j] = (uint8_t)(block >> 16);
+    }
+
+    return (invalid & SHIFTED_INVALID_VALUE) == 0;
+}
+
+B64Result b64_decode_small_input(size_t* size, uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    // Only the trailing padding is excluded, as all other characters must be encoding characters
+    size_t num_chars = src_length;
+    for (int i = 0; (i < 2) && (num_chars > 0) && (src[num_chars - 1] == PADDING); ++i) {
+        --num_chars;
+    }
+
+    if (num_chars == 0) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+    if ((num_chars % 4) == 1) {
+        // It means that the remaining length of the input is less than
+        // 1 byte (6bit), therefore decoding fails
+        return B64_ERROR_INVALID_LENGTH;
+    }
+
+    const size_t decoded_size = num_chars / 4 * 3 + ((num_chars % 4 == 0) ? 0 : (num_chars % 4 - 1));
+    if (dest_size < decoded_size) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Encoded 16, 20, 32 and 64 bytes without the padding
+    const uint8_t* chars = (const uint8_t*)src;
+    bool valid;
+    switch (num_chars) {
+        case 22:
+            valid = decode_fixed(dest, chars, 22, alphabet);
+            break;
+        case 27:
+            valid = decode_fixed(dest, chars, 27, alphabet);
+            break;
+        case 43:
+            valid = decode_fixed(dest, chars, 43, alphabet);
+            break;
+        case 86:
+            valid = decode_fixed(dest, chars, 86, alphabet);
+            break;
+        default:
+            valid = decode_fixed(dest, chars, num_chars, alphabet);
+            break;
+    }
+    if (!valid) {
+        return B64_ERROR_INVALID_CHAR;
+    }
+
+    *size = decoded_size;
+
+    return B64_SUCCESS;
+}
+
+B64Result b64_encode_small(size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size, const B64Alphabet* alphabet, const bool use_padding) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+    if (src_size == 0) {
+        return B64_ERROR_EMPTY_INPUT;
+    }
+    if (src_size > B64_SMALL_MAX_SIZE) {
+        return B64_ERROR_INVALID_LENGTH;
+    }
+    // Computed here instead of b64_get_encoded_size(), the null character is not included
+    const size_t length_required = use_padding ? ((src_size + 2) / 3 * 4) : ((src_size * 4 + 2) / 3);
+    if (dest_size <= length_required) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *length = b64_encode_small_input(dest, src, src_size, alphabet, use_padding);
+
+    return B64_SUCCESS;
+}
+
+B64Result b64_decode_small(size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    if ((dest == NULL) || (src == NULL) || (alphabet == NULL)) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+    if (src_length > B64_SMALL_MAX_LENGTH) {
+        return B64_ERROR_INVALID_LENGTH;
+    }
+
+    return b64_decode_small_input(size, dest, dest_size, src, src_length, alphabet);
+}
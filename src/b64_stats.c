@@ -0,0 +1,264 @@
+/**
+ * @file b64_stats.c
+ * @brief Statistics of the entry points, recorded with B64_STATS
+*/
+#define _POSIX_C_SOURCE 199309L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "b64.h"
+#include "b64_internal.h"
+
+#ifdef B64_STATS
+#if !defined(__GNUC__)
+// Thread-local storage (__thread) and relaxed atomic access (__atomic_*) are not in C99
+#error "B64_STATS requires GCC or Clang"
+#endif
+
+/**
+ * @brief Statistics recorded by a thread
+*/
+typedef struct ThreadStats_tag {
+    B64Stats stats; // Written only by the owner thread
+    struct ThreadStats_tag* prev; // Previous in the list of the running threads
+    struct ThreadStats_tag* next; // Next in the list of the running threads
+} ThreadStats;
+
+/**
+ * @brief Statistics of the calling thread, allocated on the first record
+*/
+static __thread ThreadStats* thread_stats = NULL;
+
+/**
+ * @brief Protect the variables below, never locked on recording
+*/
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief List of the statistics of the running threads
+*/
+static ThreadStats* thread_stats_list = NULL;
+
+/**
+ * @brief Statistics accumulated from the exited threads
+*/
+static B64Stats exited_stats;
+
+/**
+ * @brief Statistics at the last reset, subtracted from the snapshot
+*/
+static B64Stats reset_stats;
+
+/**
+ * @brief Key to release the statistics of a thread on its exit
+*/
+static pthread_key_t stats_key;
+
+static pthread_once_t stats_key_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Whether stats_key has been created, the statistics are not recorded otherwise
+*/
+static bool stats_key_created = false;
+
+/**
+ * @brief Add the value to the counter written only by the calling thread
+ *
+ * Relaxed load/store are plain moves without locking,
+ * and let other threads read the counter during the snapshot without a data race.
+ *
+ * @param[in,out] counter Counter
+ * @param[in] value Value to be added
+*/
+static inline void add_counter(uint64_t* counter, const uint64_t value) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Add all counters of the statistics
+ *
+ * @param[in,out] dest Statistics to be added to
+ * @param[in] src Statistics to be added, can be written by another thread
+*/
+static void add_stats(B64Stats* dest, const B64Stats* src) {
+    const uint64_t* src_counters = (const uint64_t*)src;
+    uint64_t* dest_counters = (uint64_t*)dest;
+    for (size_t i = 0; i < (sizeof(B64Stats) / sizeof(uint64_t)); ++i) {
+        dest_counters[i] += __atomic_load_n(&src_counters[i], __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Sum up the statistics of all threads, stats_mutex must be locked
+ *
+ * @param[out] stats Statistics
+*/
+static void sum_stats(B64Stats* stats) {
+    *stats = exited_stats;
+    for (ThreadStats* t = thread_stats_list; t != NULL; t = t->next) {
+        add_stats(stats, &t->stats);
+    }
+}
+
+/**
+ * @brief Move the statistics of an exiting thread into the exited statistics
+ *
+ * @param[in] ptr Statistics of the thread
+*/
+static void release_thread_stats(void* ptr) {
+    ThreadStats* t = ptr;
+
+    pthread_mutex_lock(&stats_mutex);
+    add_stats(&exited_stats, &t->stats);
+    if (t->prev != NULL) {
+        t->prev->next = t->next;
+    } else {
+        thread_stats_list = t->next;
+    }
+    if (t->next != NULL) {
+        t->next->prev = t->prev;
+    }
+    pthread_mutex_unlock(&stats_mutex);
+
+    // Records by later destructors of the thread allocate new statistics instead of the freed one
+    thread_stats = NULL;
+    free(t);
+}
+
+static void create_stats_key(void) {
+    stats_key_created = (pthread_key_create(&stats_key, release_thread_stats) == 0);
+}
+
+/**
+ * @brief Get the statistics of the calling thread, allocated and registered on the first call
+ *
+ * @return Statistics of the calling thread
+ * @retval NULL if the key or the allocation failed
+*/
+static ThreadStats* get_thread_stats(void) {
+    if (thread_stats != NULL) {
+        return thread_stats;
+    }
+
+    pthread_once(&stats_key_once, create_stats_key);
+    if (!stats_key_created) {
+        // The statistics would never be released on the thread exit
+        return NULL;
+    }
+
+    ThreadStats* t = calloc(1, sizeof(ThreadStats));
+    if (t == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&stats_mutex);
+    t->prev = NULL;
+    t->next = thread_stats_list;
+    if (thread_stats_list != NULL) {
+        thread_stats_list->prev = t;
+    }
+    thread_stats_list = t;
+    pthread_mutex_unlock(&stats_mutex);
+
+    pthread_setspecific(stats_key, t);
+    thread_stats = t;
+
+    return t;
+}
+
+/**
+ * @brief Get the bucket of the latency histogram
+ *
+ * @param[in] latency Latency in nanoseconds
+ * @return Index of the bucket, floor(log2(latency))
+*/
+static inline size_t get_latency_bucket(const uint64_t latency) {
+    if (latency == 0) {
+        return 0;
+    }
+
+    const size_t bucket = (size_t)(63 - __builtin_clzll(latency));
+    return (bucket < B64_STATS_NUM_LATENCY_BUCKETS) ? bucket : (B64_STATS_NUM_LATENCY_BUCKETS - 1);
+}
+
+uint64_t b64_stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void b64_stats_record(const B64StatsEntry entry, const size_t input_size, const size_t output_size, const B64Result result, const uint64_t start) {
+    const uint64_t latency = b64_stats_now() - start;
+
+    ThreadStats* t = get_thread_stats();
+    if (t == NULL) {
+        return;
+    }
+
+    B64EntryStats* stats = &t->stats.entries[entry];
+    add_counter(&stats->num_calls, 1);
+    add_counter(&stats->input_size, input_size);
+    if (result == B64_SUCCESS) {
+        add_counter(&stats->output_size, output_size);
+    }
+    add_counter(&stats->num_results[result], 1);
+    add_counter(&stats->latency_histogram[get_latency_bucket(latency)], 1);
+}
+#endif
+
+bool b64_stats_snapshot(B64Stats* stats) {
+    memset(stats, 0, sizeof(B64Stats));
+
+#ifdef B64_STATS
+    pthread_mutex_lock(&stats_mutex);
+    sum_stats(stats);
+    uint64_t* counters = (uint64_t*)stats;
+    const uint64_t* reset_counters = (const uint64_t*)&reset_stats;
+    for (size_t i = 0; i < (sizeof(B64Stats) / sizeof(uint64_t)); ++i) {
+        counters[i] -= reset_counters[i];
+    }
+    pthread_mutex_unlock(&stats_mutex);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void b64_stats_reset(void) {
+#ifdef B64_STATS
+    // The counters are written only by their own threads, so the current values are subtracted later
+    pthread_mutex_lock(&stats_mutex);
+    sum_stats(&reset_stats);
+    pthread_mutex_unlock(&stats_mutex);
+#endif
+}
+
+const char* b64_stats_entry_name(const B64StatsEntry entry) {
+    switch (entry) {
+        case B64_STATS_ENCODE:
+            return "b64_encode";
+        case B64_STATS_STD_ENCODE:
+            return "b64_std_encode";
+        case B64_STATS_URL_ENCODE:
+            return "b64_url_encode";
+        case B64_STATS_MIME_ENCODE:
+            return "b64_mime_encode";
+        case B64_STATS_DECODE:
+            return "b64_decode";
+        case B64_STATS_STD_DECODE:
+            return "b64_std_decode";
+        case B64_STATS_URL_DECODE:
+            return "b64_url_decode";
+        case B64_STATS_MIME_DECODE:
+            return "b64_mime_decode";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,143 @@
+/**
+ * @file b64_stream.c
+ * @brief Streaming Base64 encoding/decoding
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "b64.h"
+#include "b64_internal.h"
+
+/**
+ * @brief Get the length of the characters written in lines
+ *
+ * @param[in] num_chars The number of encoded characters to be written
+ * @param[in] line_length Length to insert linebreak, if 0, no linebreaks
+ * @param[in] column The number of characters in the current line
+ * @return Length of the characters including CRLF
+*/
+static size_t get_length_in_lines(const size_t num_chars, const size_t line_length, const size_t column) {
+    if ((line_length == 0) || (num_chars == 0)) {
+        return num_chars;
+    }
+
+    // CRLF is inserted before each character exceeding the line length
+    return num_chars + ((column + num_chars - 1) / line_length) * 2;
+}
+
+void b64_encode_init(B64EncodeState* state, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    state->alphabet = alphabet;
+    state->use_padding = use_padding;
+    state->line_length = line_length;
+    state->column = 0;
+    state->num_remaining_bytes = 0;
+}
+
+size_t b64_get_encode_update_size(const B64EncodeState* state, const size_t src_size) {
+    const size_t num_blocks = (state->num_remaining_bytes + src_size) / 3;
+
+    return get_length_in_lines(num_blocks * 4, state->line_length, state->column);
+}
+
+B64Result b64_encode_update(B64EncodeState* state, size_t* length, char* dest, const size_t dest_size, const void* src, const size_t src_size) {
+    if ((state == NULL) || ((dest == NULL) && (dest_size > 0)) || ((src == NULL) && (src_size > 0))) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (dest_size < b64_get_encode_update_size(state, src_size)) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    const uint8_t* input_bytes = src;
+    size_t num_input_bytes = src_size;
+    size_t buf_index = 0;
+
+    // Complete the block with the bytes remaining from the previous call
+    if ((state->num_remaining_bytes > 0) && ((state->num_remaining_bytes + num_input_bytes) >= 3)) {
+        const size_t num_to_fill = 3 - state->num_remaining_bytes;
+        memcpy(&state->remaining_bytes[state->num_remaining_bytes], input_bytes, num_to_fill);
+        input_bytes += num_to_fill;
+        num_input_bytes -= num_to_fill;
+
+        buf_index += b64_encode_blocks_in_lines(dest, state->remaining_bytes, 3, state->alphabet, state->line_length, &state->column);
+        state->num_remaining_bytes = 0;
+    }
+
+    if (num_input_bytes > 0) {
+        buf_index += b64_encode_blocks_in_lines(&dest[buf_index], input_bytes, num_input_bytes, state->alphabet, state->line_length, &state->column);
+
+        // Keep the bytes which don't fill a block
+        const size_t num_encoded_bytes = num_input_bytes / 3 * 3;
+        const size_t num_remaining_bytes = num_input_bytes - num_encoded_bytes;
+        memcpy(&state->remaining_bytes[state->num_remaining_bytes], &input_bytes[num_encoded_bytes], num_remaining_bytes);
+        state->num_remaining_bytes += num_remaining_bytes;
+    }
+
+    *length = buf_index;
+
+    return B64_SUCCESS;
+}
+
+B64Result b64_encode_final(B64EncodeState* state, size_t* length, char* dest, const size_t dest_size) {
+    if ((state == NULL) || ((dest == NULL) && (dest_size > 0))) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t num_chars = 0;
+    if (state->num_remaining_bytes > 0) {
+        num_chars = state->use_padding ? 4 : (state->num_remaining_bytes + 1);
+    }
+    if (dest_size < get_length_in_lines(num_chars, state->line_length, state->column)) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *length = b64_encode_last_block_in_lines(dest, state->remaining_bytes, state->num_remaining_bytes, state->alphabet, state->use_padding, state->line_length, &state->column);
+    state->num_remaining_bytes = 0;
+
+    return B64_SUCCESS;
+}
+
+void b64_decode_init(B64DecodeState* state, const B64Alphabet* alphabet, const bool validate) {
+    state->alphabet = alphabet;
+    state->validate = validate;
+    state->num_decoded_values = 0;
+    state->padding_found = false;
+    state->decoded_size = 0;
+    state->num_read_chars = 0;
+    state->strict = false;
+    state->require_padding = false;
+    state->num_paddings = 0;
+}
+
+void b64_decode_init_strict(B64DecodeState* state, const B64Alphabet* alphabet, const bool use_padding) {
+    b64_decode_init(state, alphabet, true);
+    state->strict = true;
+    state->require_padding = use_padding;
+}
+
+size_t b64_get_decode_update_size(const B64DecodeState* state, const size_t src_length) {
+    return (state->num_decoded_values + src_length) / 4 * 3;
+}
+
+B64Result b64_decode_update(B64DecodeState* state, size_t* size, void* dest, const size_t dest_size, const char* src, const size_t src_length) {
+    if ((state == NULL) || ((dest == NULL) && (dest_size > 0)) || ((src == NULL) && (src_length > 0))) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Check the upper bound in advance not to stop in the middle of the chunk
+    if (dest_size < b64_get_decode_update_size(state, src_length)) {
+        return B64_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    return b64_decode_chunk(state, size, dest, dest_size, src, src_length);
+}
+
+B64Result b64_decode_final(B64DecodeState* state, size_t* size, void* dest, const size_t dest_size) {
+    if ((state == NULL) || ((dest == NULL) && (dest_size > 0))) {
+        return B64_ERROR_INVALID_ARGUMENT;
+    }
+
+    return b64_decode_last_block(state, size, dest, dest_size);
+}
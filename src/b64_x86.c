@@ -0,0 +1,568 @@
+/**
+ * @file b64_x86.c
+ * @brief Base64 encoding/decoding and counting with SSSE3/AVX2 instructions, CRC32C with SSE4.2
+*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "b64_internal.h"
+
+#if !defined(B64_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define B64_X86_SIMD
+#endif
+
+#ifdef B64_X86_SIMD
+
+#include <immintrin.h>
+
+/**
+ * @brief Attribute for functions using SSSE3
+*/
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+
+/**
+ * @brief Attribute for functions using AVX2
+*/
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+/**
+ * @brief Attribute for functions using SSE4.2
+*/
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+
+/**
+ * @brief Get offsets of encoding characters from 6-bit values, used by PSHUFB
+ *
+ * Index 0: 'A'-'Z', 1: 'a'-'z', 2 to 11: '0'-'9', 12: 62nd, 13: 63rd character
+ *
+ * @param[out] offsets Offsets for the alphabet
+ * @param[in] alphabet Alphabet
+*/
+static void get_encoding_offsets(int8_t offsets[16], const B64Alphabet* alphabet) {
+    offsets[0] = 'A';
+    offsets[1] = 'a' - 26;
+    for (int i = 2; i < 12; ++i) {
+        offsets[i] = '0' - 52;
+    }
+    offsets[12] = (int8_t)(alphabet->encoding_table[62] - 62);
+    offsets[13] = (int8_t)(alphabet->encoding_table[63] - 63);
+    offsets[14] = 0;
+    offsets[15] = 0;
+}
+
+/**
+ * @brief Split 12 bytes in each 128-bit lane into 16 6-bit values
+ *
+ * @param[in] in Input bytes at the 0th to 11th bytes
+ * @return 6-bit values in each byte
+*/
+static inline TARGET_SSSE3 __m128i encode_reshuffle_ssse3(const __m128i in) {
+    // Arrange 3 input bytes [a, b, c] into 4 bytes [b, a, c, b]
+    const __m128i bytes = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    // Move the 1st and 3rd 6 bits to the lower bits of the 1st and 3rd bytes
+    const __m128i t0 = _mm_and_si128(bytes, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+
+    // Move the 2nd and 4th 6 bits to the lower bits of the 2nd and 4th bytes
+    const __m128i t2 = _mm_and_si128(bytes, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+
+    return _mm_or_si128(t1, t3);
+}
+
+/**
+ * @brief Translate 6-bit values into encoding characters
+ *
+ * @param[in] values 6-bit values
+ * @param[in] offsets Offsets given by get_encoding_offsets()
+ * @return Encoding characters
+*/
+static inline TARGET_SSSE3 __m128i encode_translate_ssse3(const __m128i values, const __m128i offsets) {
+    // 0 for 0-25, 1 for 26-51, 2 to 13 for 52-63
+    __m128i indices = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    const __m128i is_lower = _mm_cmpgt_epi8(values, _mm_set1_epi8(25));
+    indices = _mm_sub_epi8(indices, is_lower);
+
+    return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, indices));
+}
+
+/**
+ * @brief Encode 12-byte blocks by SSSE3
+ *
+ * @param[out] dest Pointer to the Base64 encoded characters
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] offsets Offsets given by get_encoding_offsets()
+ * @return Byte size of the encoded input
+*/
+static TARGET_SSSE3 size_t encode_blocks_ssse3(char* dest, const uint8_t* src, const size_t src_size, const int8_t offsets[16]) {
+    const __m128i lut = _mm_loadu_si128((const __m128i*)offsets);
+
+    size_t i = 0;
+    // 16 bytes are loaded to encode 12 bytes
+    for (; (src_size - i) >= 16; i += 12) {
+        const __m128i in = _mm_loadu_si128((const __m128i*)&src[i]);
+        const __m128i values = encode_reshuffle_ssse3(in);
+        _mm_storeu_si128((__m128i*)dest, encode_translate_ssse3(values, lut));
+        dest += 16;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Split 12 bytes in each 128-bit lane into 16 6-bit values
+ *
+ * @param[in] in Input bytes at the 0th to 11th bytes in each lane
+ * @return 6-bit values in each byte
+*/
+static inline TARGET_AVX2 __m256i encode_reshuffle_avx2(const __m256i in) {
+    const __m256i bytes = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    const __m256i t0 = _mm256_and_si256(bytes, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+
+    const __m256i t2 = _mm256_and_si256(bytes, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+
+    return _mm256_or_si256(t1, t3);
+}
+
+/**
+ * @brief Translate 6-bit values into encoding characters
+ *
+ * @param[in] values 6-bit values
+ * @param[in] offsets Offsets given by get_encoding_offsets() in each lane
+ * @return Encoding characters
+*/
+static inline TARGET_AVX2 __m256i encode_translate_avx2(const __m256i values, const __m256i offsets) {
+    __m256i indices = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+    const __m256i is_lower = _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25));
+    indices = _mm256_sub_epi8(indices, is_lower);
+
+    return _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, indices));
+}
+
+/**
+ * @brief Encode 24-byte blocks by AVX2
+ *
+ * @param[out] dest Pointer to the Base64 encoded characters
+ * @param[in] src Pointer to the input bytes
+ * @param[in] src_size Byte size of the input
+ * @param[in] offsets Offsets given by get_encoding_offsets()
+ * @return Byte size of the encoded input
+*/
+static TARGET_AVX2 size_t encode_blocks_avx2(char* dest, const uint8_t* src, const size_t src_size, const int8_t offsets[16]) {
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)offsets));
+
+    size_t i = 0;
+    // 12 bytes are encoded from each of 16 bytes at src[i] and src[i + 12]
+    for (; (src_size - i) >= 28; i += 24) {
+        const __m128i lo = _mm_loadu_si128((const __m128i*)&src[i]);
+        const __m128i hi = _mm_loadu_si128((const __m128i*)&src[i + 12]);
+        const __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        const __m256i values = encode_reshuffle_avx2(in);
+        _mm256_storeu_si256((__m256i*)dest, encode_translate_avx2(values, lut));
+        dest += 32;
+    }
+
+    return i;
+}
+
+size_t b64_simd_encode_blocks(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet) {
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    if (!has_avx2 && !has_ssse3) {
+        return 0;
+    }
+
+    int8_t offsets[16];
+    get_encoding_offsets(offsets, alphabet);
+
+    size_t encoded_size = 0;
+    if (has_avx2) {
+        encoded_size = encode_blocks_avx2(dest, src, src_size, offsets);
+    }
+    // Remaining blocks shorter than AVX2 register
+    encoded_size += encode_blocks_ssse3(&dest[encoded_size / 3 * 4], &src[encoded_size], src_size - encoded_size, offsets);
+
+    return encoded_size;
+}
+
+/**
+ * @brief Characters and offsets to translate encoding characters into 6-bit values
+*/
+typedef struct DecodingParams_tag {
+    int8_t char_62nd; // 62nd encoding character
+    int8_t char_63rd; // 63rd encoding character
+    int8_t offset_62nd; // Offset from the 62nd encoding character to 62
+    int8_t offset_63rd; // Offset from the 63rd encoding character to 63
+} DecodingParams;
+
+/**
+ * @brief Translate 16 encoding characters into 6-bit values
+ *
+ * @param[out] values 6-bit values
+ * @param[in] in Encoding characters
+ * @param[in] params Parameters for the alphabet
+ * @retval true if all characters are in the alphabet
+ * @retval false if any character is not in the alphabet
+*/
+static inline TARGET_SSSE3 bool decode_translate_ssse3(__m128i* values, const __m128i in, const DecodingParams* params) {
+    // Characters over 0x7f are negative, so out of the ranges
+    const __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8('Z' + 1)));
+    const __m128i is_lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8('z' + 1)));
+    const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8('9' + 1)));
+    const __m128i is_62nd = _mm_cmpeq_epi8(in, _mm_set1_epi8(params->char_62nd));
+    const __m128i is_63rd = _mm_cmpeq_epi8(in, _mm_set1_epi8(params->char_63rd));
+
+    const __m128i is_valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(is_upper, is_lower), _mm_or_si128(is_digit, is_62nd)), is_63rd);
+    if (_mm_movemask_epi8(is_valid) != 0xffff) {
+        return false;
+    }
+
+    __m128i offsets = _mm_and_si128(is_upper, _mm_set1_epi8(-'A'));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(is_lower, _mm_set1_epi8(26 - 'a')));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(is_digit, _mm_set1_epi8(52 - '0')));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(is_62nd, _mm_set1_epi8(params->offset_62nd)));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(is_63rd, _mm_set1_epi8(params->offset_63rd)));
+
+    *values = _mm_add_epi8(in, offsets);
+
+    return true;
+}
+
+/**
+ * @brief Pack 16 6-bit values into 12 bytes
+ *
+ * @param[in] values 6-bit values
+ * @return Decoded bytes at the 0th to 11th bytes
+*/
+static inline TARGET_SSSE3 __m128i decode_reshuffle_ssse3(const __m128i values) {
+    // Merge 4 6-bit values [a, b, c, d] into 24 bits in each 32-bit
+    const __m128i merged_ab_cd = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i merged_abcd = _mm_madd_epi16(merged_ab_cd, _mm_set1_epi32(0x00011000));
+
+    return _mm_shuffle_epi8(merged_abcd, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+/**
+ * @brief Decode 16-character blocks by SSSE3
+ *
+ * @param[out] dest Pointer to the decoded bytes
+ * @param[in] dest_size Byte size of the output buffer
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] params Parameters for the alphabet
+ * @return Length of the decoded input
+*/
+static TARGET_SSSE3 size_t decode_blocks_ssse3(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const DecodingParams* params) {
+    size_t i = 0;
+    size_t j = 0;
+    for (; ((src_length - i) >= 16) && ((dest_size - j) >= 12); i += 16, j += 12) {
+        const __m128i in = _mm_loadu_si128((const __m128i*)&src[i]);
+        __m128i values;
+        if (!decode_translate_ssse3(&values, in, params)) {
+            break;
+        }
+        const __m128i out = decode_reshuffle_ssse3(values);
+
+        // Store exactly 12 bytes
+        _mm_storel_epi64((__m128i*)&dest[j], out);
+        const uint32_t last_4bytes = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+        memcpy(&dest[j + 8], &last_4bytes, 4);
+    }
+
+    return i;
+}
+
+/**
+ * @brief Translate 32 encoding characters into 6-bit values
+ *
+ * @param[out] values 6-bit values
+ * @param[in] in Encoding characters
+ * @param[in] params Parameters for the alphabet
+ * @retval true if all characters are in the alphabet
+ * @retval false if any character is not in the alphabet
+*/
+static inline TARGET_AVX2 bool decode_translate_avx2(__m256i* values, const __m256i in, const DecodingParams* params) {
+    const __m256i is_upper = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), in));
+    const __m256i is_lower = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), in));
+    const __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+    const __m256i is_62nd = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(params->char_62nd));
+    const __m256i is_63rd = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(params->char_63rd));
+
+    const __m256i is_valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(is_upper, is_lower), _mm256_or_si256(is_digit, is_62nd)), is_63rd);
+    if ((uint32_t)_mm256_movemask_epi8(is_valid) != 0xffffffff) {
+        return false;
+    }
+
+    __m256i offsets = _mm256_and_si256(is_upper, _mm256_set1_epi8(-'A'));
+    offsets = _mm256_or_si256(offsets, _mm256_and_si256(is_lower, _mm256_set1_epi8(26 - 'a')));
+    offsets = _mm256_or_si256(offsets, _mm256_and_si256(is_digit, _mm256_set1_epi8(52 - '0')));
+    offsets = _mm256_or_si256(offsets, _mm256_and_si256(is_62nd, _mm256_set1_epi8(params->offset_62nd)));
+    offsets = _mm256_or_si256(offsets, _mm256_and_si256(is_63rd, _mm256_set1_epi8(params->offset_63rd)));
+
+    *values = _mm256_add_epi8(in, offsets);
+
+    return true;
+}
+
+/**
+ * @brief Pack 16 6-bit values into 12 bytes in each 128-bit lane
+ *
+ * @param[in] values 6-bit values
+ * @return Decoded bytes at the 0th to 11th bytes in each lane
+*/
+static inline TARGET_AVX2 __m256i decode_reshuffle_avx2(const __m256i values) {
+    const __m256i merged_ab_cd = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i merged_abcd = _mm256_madd_epi16(merged_ab_cd, _mm256_set1_epi32(0x00011000));
+
+    return _mm256_shuffle_epi8(merged_abcd, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+/**
+ * @brief Decode 32-character blocks by AVX2
+ *
+ * @param[out] dest Pointer to the decoded bytes
+ * @param[in] dest_size Byte size of the output buffer
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] params Parameters for the alphabet
+ * @return Length of the decoded input
+*/
+static TARGET_AVX2 size_t decode_blocks_avx2(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const DecodingParams* params) {
+    size_t i = 0;
+    size_t j = 0;
+    for (; ((src_length - i) >= 32) && ((dest_size - j) >= 24); i += 32, j += 24) {
+        const __m256i in = _mm256_loadu_si256((const __m256i*)&src[i]);
+        __m256i values;
+        if (!decode_translate_avx2(&values, in, params)) {
+            break;
+        }
+        const __m256i out = decode_reshuffle_avx2(values);
+
+        // Store exactly 24 bytes, 12 bytes from each lane
+        const __m256i packed = _mm256_permutevar8x32_epi32(out, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm_storeu_si128((__m128i*)&dest[j], _mm256_castsi256_si128(packed));
+        _mm_storel_epi64((__m128i*)&dest[j + 16], _mm256_extracti128_si256(packed, 1));
+    }
+
+    return i;
+}
+
+/**
+ * @brief Get the parameters to translate encoding characters of the alphabet
+ *
+ * @param[out] params Parameters for the alphabet
+ * @param[in] alphabet Alphabet
+ * @retval true if the parameters are available
+ * @retval false if the padding is in the alphabet
+*/
+static bool get_decoding_params(DecodingParams* params, const B64Alphabet* alphabet) {
+    const char char_62nd = alphabet->encoding_table[62];
+    const char char_63rd = alphabet->encoding_table[63];
+    // The padding is never decoded as an encoding character
+    if ((char_62nd == '=') || (char_63rd == '=')) {
+        return false;
+    }
+
+    params->char_62nd = (int8_t)char_62nd;
+    params->char_63rd = (int8_t)char_63rd;
+    params->offset_62nd = (int8_t)(62 - char_62nd);
+    params->offset_63rd = (int8_t)(63 - char_63rd);
+
+    return true;
+}
+
+size_t b64_simd_decode_blocks(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    if (!has_avx2 && !has_ssse3) {
+        return 0;
+    }
+
+    DecodingParams params;
+    if (!get_decoding_params(&params, alphabet)) {
+        return 0;
+    }
+
+    size_t decoded_length = 0;
+    if (has_avx2) {
+        decoded_length = decode_blocks_avx2(dest, dest_size, src, src_length, &params);
+    }
+    // Remaining blocks shorter than AVX2 register, or a block with an invalid character
+    decoded_length += decode_blocks_ssse3(&dest[decoded_length / 4 * 3], dest_size - decoded_length / 4 * 3, &src[decoded_length], src_length - decoded_length, &params);
+
+    return decoded_length;
+}
+
+/**
+ * @brief Count the encoding characters in 16-character blocks by SSSE3
+ *
+ * @param[in,out] num_chars The number of the encoding characters
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] params Parameters for the alphabet
+ * @return Length of the counted input, stops before a block including the padding
+*/
+static TARGET_SSSE3 size_t count_chars_ssse3(size_t* num_chars, const char* src, const size_t src_length, const DecodingParams* params) {
+    size_t i = 0;
+    for (; (src_length - i) >= 16; i += 16) {
+        const __m128i in = _mm_loadu_si128((const __m128i*)&src[i]);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('='))) != 0) {
+            break;
+        }
+
+        const __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8('Z' + 1)));
+        const __m128i is_lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8('z' + 1)));
+        const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8('9' + 1)));
+        const __m128i is_62nd = _mm_cmpeq_epi8(in, _mm_set1_epi8(params->char_62nd));
+        const __m128i is_63rd = _mm_cmpeq_epi8(in, _mm_set1_epi8(params->char_63rd));
+        const __m128i is_valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(is_upper, is_lower), _mm_or_si128(is_digit, is_62nd)), is_63rd);
+
+        *num_chars += (size_t)__builtin_popcount((unsigned int)_mm_movemask_epi8(is_valid));
+    }
+
+    return i;
+}
+
+/**
+ * @brief Count the encoding characters in 32-character blocks by AVX2
+ *
+ * @param[in,out] num_chars The number of the encoding characters
+ * @param[in] src Pointer to the input string
+ * @param[in] src_length Length of the input string
+ * @param[in] params Parameters for the alphabet
+ * @return Length of the counted input, stops before a block including the padding
+*/
+static TARGET_AVX2 size_t count_chars_avx2(size_t* num_chars, const char* src, const size_t src_length, const DecodingParams* params) {
+    size_t i = 0;
+    for (; (src_length - i) >= 32; i += 32) {
+        const __m256i in = _mm256_loadu_si256((const __m256i*)&src[i]);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('='))) != 0) {
+            break;
+        }
+
+        const __m256i is_upper = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), in));
+        const __m256i is_lower = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), in));
+        const __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+        const __m256i is_62nd = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(params->char_62nd));
+        const __m256i is_63rd = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(params->char_63rd));
+        const __m256i is_valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(is_upper, is_lower), _mm256_or_si256(is_digit, is_62nd)), is_63rd);
+
+        *num_chars += (size_t)__builtin_popcount((uint32_t)_mm256_movemask_epi8(is_valid));
+    }
+
+    return i;
+}
+
+size_t b64_simd_count_chars(size_t* num_chars, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    if (!has_avx2 && !has_ssse3) {
+        return 0;
+    }
+
+    DecodingParams params;
+    if (!get_decoding_params(&params, alphabet)) {
+        return 0;
+    }
+
+    size_t counted_length = 0;
+    if (has_avx2) {
+        counted_length = count_chars_avx2(num_chars, src, src_length, &params);
+    }
+    // Remaining blocks shorter than AVX2 register, or a block with the padding
+    counted_length += count_chars_ssse3(num_chars, &src[counted_length], src_length - counted_length, &params);
+
+    return counted_length;
+}
+
+/**
+ * @brief Update CRC32C by the CRC32 instruction of SSE4.2
+ *
+ * @param[in] crc CRC32C so far, not inverted
+ * @param[in] data Pointer to the data
+ * @param[in] size Byte size of the data
+ * @return Updated CRC32C, not inverted
+*/
+static TARGET_SSE42 uint32_t crc32c_sse42(uint32_t crc, const uint8_t* data, const size_t size) {
+    size_t i = 0;
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; (size - i) >= 8; i += 8) {
+        uint64_t value;
+        memcpy(&value, &data[i], sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = (uint32_t)crc64;
+#endif
+    for (; (size - i) >= 4; i += 4) {
+        uint32_t value;
+        memcpy(&value, &data[i], sizeof(value));
+        crc = _mm_crc32_u32(crc, value);
+    }
+    for (; i < size; ++i) {
+        crc = _mm_crc32_u8(crc, data[i]);
+    }
+
+    return crc;
+}
+
+size_t b64_simd_crc32c(uint32_t* crc, const uint8_t* data, const size_t size) {
+    if (!__builtin_cpu_supports("sse4.2")) {
+        return 0;
+    }
+
+    *crc = crc32c_sse42(*crc, data, size);
+
+    return size;
+}
+
+#else
+
+size_t b64_simd_encode_blocks(char* dest, const uint8_t* src, const size_t src_size, const B64Alphabet* alphabet) {
+    (void)dest;
+    (void)src;
+    (void)src_size;
+    (void)alphabet;
+
+    return 0;
+}
+
+size_t b64_simd_decode_blocks(uint8_t* dest, const size_t dest_size, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    (void)dest;
+    (void)dest_size;
+    (void)src;
+    (void)src_length;
+    (void)alphabet;
+
+    return 0;
+}
+
+size_t b64_simd_count_chars(size_t* num_chars, const char* src, const size_t src_length, const B64Alphabet* alphabet) {
+    (void)num_chars;
+    (void)src;
+    (void)src_length;
+    (void)alphabet;
+
+    return 0;
+}
+
+size_t b64_simd_crc32c(uint32_t* crc, const uint8_t* data, const size_t size) {
+    (void)crc;
+    (void)data;
+    (void)size;
+
+    return 0;
+}
+
+#endif // B64_X86_SIMD
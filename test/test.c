@@ -1,3 +1,4 @@
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -184,6 +185,361 @@ void test_encoding_with_specified_chars(void) {
     FREE_NULL(encoded_str);
 }
 
+void test_encoding_with_alphabet(void) {
+    static uint8_t input_bytes[] = { 0xf3, 0xdf, 0xbf };
+
+    size_t length;
+
+    char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, sizeof(input_bytes), &b64_std_alphabet, true, 0);
+    ASSERT_SIZE_EQ(4, length);
+    ASSERT_STR_EQ("89+/", encoded_str);
+    FREE_NULL(encoded_str);
+
+    encoded_str = b64_encode_with_alphabet(&length, input_bytes, sizeof(input_bytes), &b64_url_alphabet, false, 0);
+    ASSERT_SIZE_EQ(4, length);
+    ASSERT_STR_EQ("89-_", encoded_str);
+    FREE_NULL(encoded_str);
+
+    B64Alphabet alphabet;
+    ASSERT_TRUE(b64_init_alphabet(&alphabet, (char[]){'?', '@'}));
+
+    encoded_str = b64_encode_with_alphabet(&length, input_bytes, sizeof(input_bytes), &alphabet, true, 0);
+    ASSERT_SIZE_EQ(4, length);
+    ASSERT_STR_EQ("89?@", encoded_str);
+    FREE_NULL(encoded_str);
+}
+
+void test_encoding_with_arena(void) {
+    // Room for 2 encoded strings of 65 bytes aligned by 16 bytes
+    const size_t arena_size = 160;
+    uint8_t* arena_buf = malloc(arena_size);
+    B64Arena arena;
+    b64_arena_init(&arena, arena_buf, arena_size);
+    B64Allocator allocator = b64_arena_allocator(&arena);
+
+    size_t length;
+    char* encoded_str = b64_encode_with_allocator(&length, BYTES_OF_ALL_B64_CHARS, sizeof(BYTES_OF_ALL_B64_CHARS), &b64_std_alphabet, true, 0, &allocator);
+    ASSERT_SIZE_EQ(strlen(ALL_B64_CHARS), length);
+    ASSERT_STR_EQ(ALL_B64_CHARS, encoded_str);
+    ASSERT_TRUE(((uintptr_t)encoded_str % 16) == 0);
+
+    // The second allocation is aligned and doesn't overlap the first
+    char* encoded_str2 = b64_encode_with_allocator(&length, BYTES_OF_ALL_B64_CHARS, sizeof(BYTES_OF_ALL_B64_CHARS), &b64_url_alphabet, false, 0, &allocator);
+    ASSERT_STR_EQ(ALL_B64_CHARS_URL_SAFE, encoded_str2);
+    ASSERT_STR_EQ(ALL_B64_CHARS, encoded_str);
+    ASSERT_TRUE(((uintptr_t)encoded_str2 % 16) == 0);
+
+    // Fails when the rest of the arena is not enough
+    ASSERT_NULL(b64_encode_with_allocator(&length, BYTES_OF_ALL_B64_CHARS, sizeof(BYTES_OF_ALL_B64_CHARS), &b64_std_alphabet, true, 0, &allocator));
+
+    b64_arena_reset(&arena);
+    encoded_str = b64_encode_with_allocator(&length, BYTES_OF_ALL_B64_CHARS, sizeof(BYTES_OF_ALL_B64_CHARS), &b64_std_alphabet, true, 0, &allocator);
+    ASSERT_STR_EQ(ALL_B64_CHARS, encoded_str);
+
+    FREE_NULL(arena_buf);
+}
+
+void test_encoding_into_buffer(void) {
+    size_t buf_size = b64_get_encoded_size(sizeof(BYTES_OF_B64_CHARS_OVER_76_CHARS), true, B64_MIME_LINE_LENGTH);
+    ASSERT_SIZE_EQ(strlen(B64_CHARS_OVER_76_CHARS_WITH_CRLF) + 1, buf_size);
+
+    char buf[128];
+    size_t length;
+
+    B64Result result = b64_encode_into(&length, buf, buf_size, BYTES_OF_B64_CHARS_OVER_76_CHARS, sizeof(BYTES_OF_B64_CHARS_OVER_76_CHARS), &b64_std_alphabet, true, B64_MIME_LINE_LENGTH);
+    ASSERT_SIZE_EQ(B64_SUCCESS, result);
+    ASSERT_SIZE_EQ(strlen(B64_CHARS_OVER_76_CHARS_WITH_CRLF), length);
+    ASSERT_STR_EQ(B64_CHARS_OVER_76_CHARS_WITH_CRLF, buf);
+
+    result = b64_encode_into(&length, buf, sizeof(buf), BYTES_OF_ALL_B64_CHARS, sizeof(BYTES_OF_ALL_B64_CHARS), &b64_url_alphabet, false, 0);
+    ASSERT_SIZE_EQ(B64_SUCCESS, result);
+    ASSERT_SIZE_EQ(strlen(ALL_B64_CHARS_URL_SAFE), length);
+    ASSERT_STR_EQ(ALL_B64_CHARS_URL_SAFE, buf);
+}
+
+void test_encoding_into_buffer_fails(void) {
+    uint8_t input_bytes[] = { 0xff, 0xff };
+
+    char buf[5];
+    size_t length;
+
+    ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_encode_into(&length, buf, 4, input_bytes, sizeof(input_bytes), &b64_std_alphabet, true, 0));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64_encode_into(&length, buf, sizeof(buf), input_bytes, 0, &b64_std_alphabet, true, 0));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_ARGUMENT, b64_encode_into(&length, NULL, sizeof(buf), input_bytes, sizeof(input_bytes), &b64_std_alphabet, true, 0));
+}
+
+// Encode bytes in the straightforward way to verify the optimized encoder
+static size_t encode_for_reference(char* dest, const uint8_t* src, const size_t src_size, const char* table, const bool use_padding) {
+    size_t length = 0;
+    for (size_t i = 0; i < src_size; i += 3) {
+        uint32_t block = (uint32_t)src[i] << 16;
+        if ((i + 1) < src_size) {
+            block |= (uint32_t)src[i + 1] << 8;
+        }
+        if ((i + 2) < src_size) {
+            block |= src[i + 2];
+        }
+        size_t num_chars = ((src_size - i) >= 3) ? 4 : (src_size - i + 1);
+        for (size_t j = 0; j < 4; ++j) {
+            if (j < num_chars) {
+                dest[length++] = table[(block >> (18 - 6 * j)) & 0x3f];
+            } else if (use_padding) {
+                dest[length++] = '=';
+            }
+        }
+    }
+    dest[length] = '\0';
+
+    return length;
+}
+
+void test_encoding_various_sizes(void) {
+    uint8_t input_bytes[300];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    B64Alphabet alphabet;
+    ASSERT_TRUE(b64_init_alphabet(&alphabet, (char[]){'?', '@'}));
+
+    char expected[401];
+    for (size_t src_size = 1; src_size <= sizeof(input_bytes); ++src_size) {
+        size_t length;
+
+        size_t exp_length = encode_for_reference(expected, input_bytes, src_size, ALL_B64_CHARS, true);
+        char* encoded_str = b64_std_encode(&length, input_bytes, src_size);
+        ASSERT_SIZE_EQ(exp_length, length);
+        ASSERT_STR_EQ(expected, encoded_str);
+        FREE_NULL(encoded_str);
+
+        exp_length = encode_for_reference(expected, input_bytes, src_size, ALL_B64_CHARS_URL_SAFE, false);
+        encoded_str = b64_url_encode(&length, input_bytes, src_size);
+        ASSERT_SIZE_EQ(exp_length, length);
+        ASSERT_STR_EQ(expected, encoded_str);
+        FREE_NULL(encoded_str);
+
+        exp_length = encode_for_reference(expected, input_bytes, src_size, alphabet.encoding_table, true);
+        encoded_str = b64_encode_with_alphabet(&length, input_bytes, src_size, &alphabet, true, 0);
+        ASSERT_SIZE_EQ(exp_length, length);
+        ASSERT_STR_EQ(expected, encoded_str);
+        FREE_NULL(encoded_str);
+    }
+}
+
+// Encode the input by the stream in the chunks of the size
+static size_t encode_by_stream(char* dest, const uint8_t* src, const size_t src_size, const size_t chunk_size, const B64Alphabet* alphabet, const bool use_padding, const size_t line_length) {
+    B64EncodeState state;
+    b64_encode_init(&state, alphabet, use_padding, line_length);
+
+    size_t total_length = 0;
+    for (size_t i = 0; i < src_size; i += chunk_size) {
+        size_t size = ((src_size - i) < chunk_size) ? (src_size - i) : chunk_size;
+        size_t length;
+        if (b64_encode_update(&state, &length, &dest[total_length], b64_get_encode_update_size(&state, size), &src[i], size) != B64_SUCCESS) {
+            return 0;
+        }
+        total_length += length;
+    }
+
+    size_t length;
+    if (b64_encode_final(&state, &length, &dest[total_length], B64_ENCODE_FINAL_SIZE) != B64_SUCCESS) {
+        return 0;
+    }
+    total_length += length;
+    dest[total_length] = '\0';
+
+    return total_length;
+}
+
+void test_encoding_by_stream(void) {
+    uint8_t input_bytes[500];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    static const size_t line_lengths[] = { 0, 3, 4, B64_MIME_LINE_LENGTH };
+
+    char stream_str[1200];
+    for (size_t i = 0; i < (sizeof(line_lengths) / sizeof(line_lengths[0])); ++i) {
+        size_t length;
+        char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, sizeof(input_bytes) - i, &b64_std_alphabet, (i % 2) == 0, line_lengths[i]);
+
+        for (size_t chunk_size = 1; chunk_size <= 70; ++chunk_size) {
+            size_t stream_length = encode_by_stream(stream_str, input_bytes, sizeof(input_bytes) - i, chunk_size, &b64_std_alphabet, (i % 2) == 0, line_lengths[i]);
+            ASSERT_SIZE_EQ(length, stream_length);
+            ASSERT_STR_EQ(encoded_str, stream_str);
+        }
+
+        FREE_NULL(encoded_str);
+    }
+}
+
+void test_encoding_in_parallel(void) {
+    const size_t input_size = 1024 * 1024 + 2;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    static const size_t line_lengths[] = { 0, 5, B64_MIME_LINE_LENGTH };
+
+    B64ThreadPool* pool = b64_thread_pool_create(4);
+    ASSERT_SIZE_EQ(4, b64_thread_pool_get_num_threads(pool));
+
+    for (size_t i = 0; i < (sizeof(line_lengths) / sizeof(line_lengths[0])); ++i) {
+        const size_t src_size = input_size - i;
+        size_t length;
+        char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, src_size, &b64_std_alphabet, true, line_lengths[i]);
+
+        const size_t buf_size = b64_get_encoded_size(src_size, true, line_lengths[i]);
+        char* buf = malloc(buf_size);
+        size_t parallel_length;
+        ASSERT_SIZE_EQ(B64_SUCCESS, b64_parallel_encode_into(pool, &parallel_length, buf, buf_size, input_bytes, src_size, &b64_std_alphabet, true, line_lengths[i]));
+        ASSERT_SIZE_EQ(length, parallel_length);
+        ASSERT_STR_EQ(encoded_str, buf);
+
+        ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_parallel_encode_into(pool, &parallel_length, buf, buf_size - 1, input_bytes, src_size, &b64_std_alphabet, true, line_lengths[i]));
+
+        FREE_NULL(buf);
+        FREE_NULL(encoded_str);
+    }
+
+    b64_thread_pool_destroy(pool);
+    FREE_NULL(input_bytes);
+}
+
+void test_encoding_in_batch(void) {
+    uint8_t input_bytes[100];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    // Inputs of 0 to 69 bytes
+    B64Span srcs[70];
+    for (size_t i = 0; i < (sizeof(srcs) / sizeof(srcs[0])); ++i) {
+        srcs[i].data = &input_bytes[i % 30];
+        srcs[i].size = i;
+    }
+    const size_t num_srcs = sizeof(srcs) / sizeof(srcs[0]);
+
+    size_t offsets[71];
+    const size_t buf_size = b64_get_batch_encoded_size(srcs, num_srcs, false, 0);
+    char* buf = malloc(buf_size);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_encode_batch(offsets, buf, buf_size, srcs, num_srcs, &b64_url_alphabet, false, 0));
+    ASSERT_SIZE_EQ(0, offsets[0]);
+    ASSERT_SIZE_EQ(buf_size, offsets[num_srcs]);
+    ASSERT_SIZE_EQ(0, offsets[1]);
+
+    for (size_t i = 1; i < num_srcs; ++i) {
+        size_t length;
+        char* encoded_str = b64_url_encode(&length, srcs[i].data, srcs[i].size);
+        ASSERT_SIZE_EQ(length, offsets[i + 1] - offsets[i]);
+        ASSERT_MEM_EQ((uint8_t*)encoded_str, (uint8_t*)&buf[offsets[i]], length);
+        FREE_NULL(encoded_str);
+    }
+
+    ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_encode_batch(offsets, buf, buf_size - 1, srcs, num_srcs, &b64_url_alphabet, false, 0));
+    FREE_NULL(buf);
+
+    // Large input among the small inputs, with linebreaks
+    uint8_t* large_input_bytes = malloc(5000);
+    for (size_t i = 0; i < 5000; ++i) {
+        large_input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+    srcs[1].data = large_input_bytes;
+    srcs[1].size = 5000;
+    for (size_t line_length = 0; line_length <= B64_MIME_LINE_LENGTH; line_length += B64_MIME_LINE_LENGTH) {
+        const size_t large_buf_size = b64_get_batch_encoded_size(srcs, 3, true, line_length);
+        buf = malloc(large_buf_size);
+        ASSERT_SIZE_EQ(B64_SUCCESS, b64_encode_batch(offsets, buf, large_buf_size, srcs, 3, &b64_std_alphabet, true, line_length));
+        for (size_t i = 1; i < 3; ++i) {
+            size_t length;
+            char* encoded_str = b64_encode_with_alphabet(&length, srcs[i].data, srcs[i].size, &b64_std_alphabet, true, line_length);
+            ASSERT_SIZE_EQ(length, offsets[i + 1] - offsets[i]);
+            ASSERT_MEM_EQ((uint8_t*)encoded_str, (uint8_t*)&buf[offsets[i]], length);
+            FREE_NULL(encoded_str);
+        }
+        FREE_NULL(buf);
+    }
+    FREE_NULL(large_input_bytes);
+}
+
+void test_encoding_small(void) {
+    uint8_t input_bytes[B64_SMALL_MAX_SIZE + 1];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    // The specialized sizes (16, 20, 32 and 64 bytes) and the others, same as the general encoding
+    char buf[B64_SMALL_MAX_LENGTH + 1];
+    for (size_t src_size = 1; src_size <= B64_SMALL_MAX_SIZE; ++src_size) {
+        for (int padding = 0; padding <= 1; ++padding) {
+            const B64Alphabet* alphabet = padding ? &b64_std_alphabet : &b64_url_alphabet;
+            size_t exp_length;
+            char* encoded_str = b64_encode_with_alphabet(&exp_length, input_bytes, src_size, alphabet, padding, 0);
+
+            const size_t buf_size = b64_get_encoded_size(src_size, padding, 0);
+            size_t length;
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_encode_small(&length, buf, buf_size, input_bytes, src_size, alphabet, padding));
+            ASSERT_SIZE_EQ(exp_length, length);
+            ASSERT_STR_EQ(encoded_str, buf);
+
+            ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_encode_small(&length, buf, buf_size - 1, input_bytes, src_size, alphabet, padding));
+            FREE_NULL(encoded_str);
+        }
+    }
+
+    size_t length;
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, b64_encode_small(&length, buf, sizeof(buf), input_bytes, B64_SMALL_MAX_SIZE + 1, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64_encode_small(&length, buf, sizeof(buf), input_bytes, 0, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_ARGUMENT, b64_encode_small(&length, buf, sizeof(buf), input_bytes, 16, NULL, true));
+}
+
+void test_encoding_with_digest(void) {
+    // Check values of CRC32C and XXH64
+    ASSERT_SIZE_EQ(0xe3069283, b64_crc32c(0, "123456789", 9));
+    uint8_t zero_bytes[32] = { 0x00 };
+    ASSERT_SIZE_EQ(0x8a9136aa, b64_crc32c(0, zero_bytes, sizeof(zero_bytes)));
+    ASSERT_SIZE_EQ(0x8a9136aa, b64_crc32c(b64_crc32c(0, zero_bytes, 13), &zero_bytes[13], sizeof(zero_bytes) - 13));
+    ASSERT_SIZE_EQ(0xef46db3751d8e999, b64_xxh64("", 0, 0));
+    ASSERT_SIZE_EQ(0x44bc2cf5ad770999, b64_xxh64("abc", 3, 0));
+
+    const size_t input_size = 10000;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    for (size_t line_length = 0; line_length <= B64_MIME_LINE_LENGTH; line_length += B64_MIME_LINE_LENGTH) {
+        for (size_t src_size = 1; src_size <= input_size; src_size = src_size * 3 + 1) {
+            size_t exp_length;
+            char* exp_str = b64_encode_with_alphabet(&exp_length, input_bytes, src_size, &b64_std_alphabet, true, line_length);
+
+            const size_t buf_size = b64_get_encoded_size(src_size, true, line_length);
+            char* buf = malloc(buf_size);
+            size_t length;
+            B64Digest digest;
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_encode_into_with_digest(&length, buf, buf_size, input_bytes, src_size, &b64_std_alphabet, true, line_length, B64_DIGEST_CRC32C | B64_DIGEST_XXH64, &digest));
+            ASSERT_SIZE_EQ(exp_length, length);
+            ASSERT_MEM_EQ((uint8_t*)exp_str, (uint8_t*)buf, length + 1);
+            ASSERT_SIZE_EQ(b64_crc32c(0, input_bytes, src_size), digest.crc32c);
+            ASSERT_SIZE_EQ(b64_xxh64(input_bytes, src_size, 0), digest.xxh64);
+
+            // Only the specified checksum is computed
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_encode_into_with_digest(&length, buf, buf_size, input_bytes, src_size, &b64_std_alphabet, true, line_length, B64_DIGEST_XXH64, &digest));
+            ASSERT_SIZE_EQ(0, digest.crc32c);
+            ASSERT_SIZE_EQ(b64_xxh64(input_bytes, src_size, 0), digest.xxh64);
+
+            ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_encode_into_with_digest(&length, buf, buf_size - 1, input_bytes, src_size, &b64_std_alphabet, true, line_length, B64_DIGEST_CRC32C, &digest));
+
+            FREE_NULL(buf);
+            FREE_NULL(exp_str);
+        }
+    }
+
+    FREE_NULL(input_bytes);
+}
+
 void test_encoding_fails_when_input_size_is_0(void) {
     uint8_t input_bytes[] = { 0x00 };
 
@@ -299,6 +655,727 @@ void test_decoding_with_specified_chars(void) {
     FREE_NULL(output_bytes);
 }
 
+void test_decoding_with_alphabet(void) {
+    static uint8_t original_bytes[] = { 0xf3, 0xdf, 0xbf };
+
+    size_t size;
+
+    uint8_t* output_bytes = b64_decode_with_alphabet(&size, "89+/", &b64_std_alphabet, true);
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    output_bytes = b64_decode_with_alphabet(&size, "89-_", &b64_url_alphabet, true);
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    B64Alphabet alphabet;
+    ASSERT_TRUE(b64_init_alphabet(&alphabet, (char[]){'?', '@'}));
+
+    output_bytes = b64_decode_with_alphabet(&size, "89?@", &alphabet, true);
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    ASSERT_NULL(b64_decode_with_alphabet(&size, "89+/", &alphabet, true));
+}
+
+void test_alphabet_init_same_as_predefined(void) {
+    // Tables built at runtime are identical to the ones built at compile time
+    B64Alphabet alphabet;
+    ASSERT_TRUE(b64_init_alphabet(&alphabet, (char[]){'+', '/'}));
+    ASSERT_MEM_EQ((const uint8_t*)&b64_std_alphabet, (uint8_t*)&alphabet, sizeof(B64Alphabet));
+    ASSERT_TRUE(b64_init_alphabet(&alphabet, (char[]){'-', '_'}));
+    ASSERT_MEM_EQ((const uint8_t*)&b64_url_alphabet, (uint8_t*)&alphabet, sizeof(B64Alphabet));
+}
+
+void test_alphabet_init_fails_with_invalid_chars(void) {
+    B64Alphabet alphabet;
+
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'A', '/'}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'+', '0'}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'+', '+'}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'\0', '/'}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'=', '*'}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'+', '='}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'\r', '/'}));
+    ASSERT_FALSE(b64_init_alphabet(&alphabet, (char[]){'+', '\n'}));
+
+    // Padding and CR/LF are rejected on decoding with the characters as well
+    size_t size;
+    ASSERT_NULL(b64_decode(&size, "QQ==", (char[]){'=', '/'}, true));
+    ASSERT_NULL(b64_decode(&size, "QQ==", (char[]){'+', '\r'}, true));
+}
+
+void test_decoding_finishes_at_padding(void) {
+    uint8_t original_bytes[] = { 0x41 };
+
+    size_t size;
+
+    uint8_t* output_bytes = b64_std_decode(&size, "QQ==QUJD");
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    output_bytes = b64_mime_decode(&size, "QQ==?");
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    // Characters after the padding are also validated
+    ASSERT_NULL(b64_std_decode(&size, "QQ==?"));
+}
+
+void test_decoding_with_length(void) {
+    // Slice of the buffer without null character
+    char input_b64_chars[] = { '/', '/', '8', '=', '/', 'w', '=', '=' };
+    uint8_t original_bytes[] = { 0xff, 0xff };
+
+    size_t size;
+
+    uint8_t* output_bytes = b64_std_decode_n(&size, input_b64_chars, 4);
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    output_bytes = b64_mime_decode_n(&size, input_b64_chars, 4);
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    output_bytes = b64_url_decode_n(&size, "__8__8", 3);
+    ASSERT_SIZE_EQ(sizeof(original_bytes), size);
+    ASSERT_MEM_EQ(original_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    ASSERT_SIZE_EQ(1, b64_get_decoded_size_n(&input_b64_chars[4], 4, &b64_std_alphabet));
+
+    uint8_t buf[3];
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_n(&size, buf, sizeof(buf), &input_b64_chars[4], 2, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(1, size);
+    ASSERT_SIZE_EQ(0xff, buf[0]);
+
+    ASSERT_NULL(b64_std_decode_n(&size, input_b64_chars, 0));
+}
+
+void test_decoding_various_sizes(void) {
+    uint8_t input_bytes[300];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    char encoded_str[401];
+    for (size_t src_size = 1; src_size <= sizeof(input_bytes); ++src_size) {
+        size_t size;
+
+        encode_for_reference(encoded_str, input_bytes, src_size, ALL_B64_CHARS, true);
+        uint8_t* output_bytes = b64_std_decode(&size, encoded_str);
+        ASSERT_SIZE_EQ(src_size, size);
+        ASSERT_MEM_EQ(input_bytes, output_bytes, size);
+        FREE_NULL(output_bytes);
+
+        encode_for_reference(encoded_str, input_bytes, src_size, ALL_B64_CHARS_URL_SAFE, false);
+        output_bytes = b64_url_decode(&size, encoded_str);
+        ASSERT_SIZE_EQ(src_size, size);
+        ASSERT_MEM_EQ(input_bytes, output_bytes, size);
+        FREE_NULL(output_bytes);
+    }
+}
+
+void test_mime_decoding_long_lines(void) {
+    uint8_t input_bytes[1000];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    size_t length;
+    char* encoded_str = b64_mime_encode(&length, input_bytes, sizeof(input_bytes));
+
+    size_t size;
+    uint8_t* output_bytes = b64_mime_decode(&size, encoded_str);
+    ASSERT_SIZE_EQ(sizeof(input_bytes), size);
+    ASSERT_MEM_EQ(input_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    // CRLF is allowed in the standard decoding
+    output_bytes = b64_std_decode(&size, encoded_str);
+    ASSERT_SIZE_EQ(sizeof(input_bytes), size);
+    ASSERT_MEM_EQ(input_bytes, output_bytes, size);
+    FREE_NULL(output_bytes);
+
+    FREE_NULL(encoded_str);
+}
+
+// Decode the input by the stream in the chunks of the length
+static B64Result decode_by_stream(size_t* size, uint8_t* dest, const char* src, const size_t src_length, const size_t chunk_length, const B64Alphabet* alphabet, const bool validate) {
+    B64DecodeState state;
+    b64_decode_init(&state, alphabet, validate);
+
+    size_t total_size = 0;
+    for (size_t i = 0; i < src_length; i += chunk_length) {
+        size_t length = ((src_length - i) < chunk_length) ? (src_length - i) : chunk_length;
+        size_t decoded_size;
+        B64Result result = b64_decode_update(&state, &decoded_size, &dest[total_size], b64_get_decode_update_size(&state, length), &src[i], length);
+        if (result != B64_SUCCESS) {
+            return result;
+        }
+        total_size += decoded_size;
+    }
+
+    size_t decoded_size;
+    B64Result result = b64_decode_final(&state, &decoded_size, &dest[total_size], B64_DECODE_FINAL_SIZE);
+    if (result != B64_SUCCESS) {
+        return result;
+    }
+    *size = total_size + decoded_size;
+
+    return B64_SUCCESS;
+}
+
+void test_decoding_by_stream(void) {
+    uint8_t input_bytes[500];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    static const size_t line_lengths[] = { 0, 3, 4, B64_MIME_LINE_LENGTH };
+
+    uint8_t output_bytes[500];
+    for (size_t i = 0; i < (sizeof(line_lengths) / sizeof(line_lengths[0])); ++i) {
+        size_t length;
+        char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, sizeof(input_bytes) - i, &b64_url_alphabet, (i % 2) == 0, line_lengths[i]);
+
+        // CRLF may be split across the chunks
+        for (size_t chunk_length = 1; chunk_length <= 70; ++chunk_length) {
+            size_t size = 0;
+            ASSERT_SIZE_EQ(B64_SUCCESS, decode_by_stream(&size, output_bytes, encoded_str, length, chunk_length, &b64_url_alphabet, true));
+            ASSERT_SIZE_EQ(sizeof(input_bytes) - i, size);
+            ASSERT_MEM_EQ(input_bytes, output_bytes, size);
+        }
+
+        FREE_NULL(encoded_str);
+    }
+
+    char input_b64_chars[] = "QUJD\r\nREVG=\r\n!";
+    size_t size;
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, decode_by_stream(&size, output_bytes, input_b64_chars, strlen(input_b64_chars), 5, &b64_std_alphabet, true));
+
+    // The rest is ignored after the padding without validation
+    ASSERT_SIZE_EQ(B64_SUCCESS, decode_by_stream(&size, output_bytes, input_b64_chars, strlen(input_b64_chars), 5, &b64_std_alphabet, false));
+    uint8_t exp_bytes[] = { 'A', 'B', 'C', 'D', 'E', 'F' };
+    ASSERT_SIZE_EQ(sizeof(exp_bytes), size);
+    ASSERT_MEM_EQ(exp_bytes, output_bytes, size);
+
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, decode_by_stream(&size, output_bytes, "QUJDR", 5, 2, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, decode_by_stream(&size, output_bytes, "\r\n", 2, 1, &b64_std_alphabet, true));
+}
+
+void test_decoding_in_parallel(void) {
+    const size_t input_size = 1024 * 1024 + 2;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    static const size_t line_lengths[] = { 0, 5, B64_MIME_LINE_LENGTH };
+
+    B64ThreadPool* pool = b64_thread_pool_create(4);
+    uint8_t* buf = malloc(input_size);
+
+    for (size_t i = 0; i < (sizeof(line_lengths) / sizeof(line_lengths[0])); ++i) {
+        const size_t src_size = input_size - i;
+        size_t length;
+        char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, src_size, &b64_std_alphabet, true, line_lengths[i]);
+
+        size_t size;
+        ASSERT_SIZE_EQ(B64_SUCCESS, b64_parallel_decode_into(pool, &size, buf, input_size, encoded_str, length, &b64_std_alphabet, true));
+        ASSERT_SIZE_EQ(src_size, size);
+        ASSERT_MEM_EQ(input_bytes, buf, size);
+
+        ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_parallel_decode_into(pool, &size, buf, src_size - 1, encoded_str, length, &b64_std_alphabet, true));
+
+        FREE_NULL(encoded_str);
+    }
+
+    // Non encoding characters are skipped without validation
+    size_t length;
+    char* encoded_str = b64_std_encode(&length, input_bytes, input_size);
+    for (size_t i = 0; i < length; i += 1001) {
+        encoded_str[i] = '!';
+    }
+    size_t size;
+    size_t exp_size;
+    uint8_t* exp_bytes = b64_decode_with_alphabet_n(&exp_size, encoded_str, length, &b64_std_alphabet, false);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_parallel_decode_into(pool, &size, buf, input_size, encoded_str, length, &b64_std_alphabet, false));
+    ASSERT_SIZE_EQ(exp_size, size);
+    ASSERT_MEM_EQ(exp_bytes, buf, size);
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_parallel_decode_into(pool, &size, buf, input_size, encoded_str, length, &b64_std_alphabet, true));
+    FREE_NULL(exp_bytes);
+
+    // Decoding finishes at padding in the middle of the input
+    encoded_str[length / 3] = '=';
+    exp_bytes = b64_decode_with_alphabet_n(&exp_size, encoded_str, length, &b64_std_alphabet, false);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_parallel_decode_into(pool, &size, buf, input_size, encoded_str, length, &b64_std_alphabet, false));
+    ASSERT_SIZE_EQ(exp_size, size);
+    ASSERT_MEM_EQ(exp_bytes, buf, size);
+    FREE_NULL(exp_bytes);
+
+    // The same error as in the calling thread with a small buffer, by the first error in the input
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_parallel_decode_into(NULL, &size, buf, 1024, encoded_str, length, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_parallel_decode_into(pool, &size, buf, 1024, encoded_str, length, &b64_std_alphabet, true));
+    FREE_NULL(encoded_str);
+    encoded_str = b64_std_encode(&length, input_bytes, input_size);
+    encoded_str[length - 10] = '!';
+    ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_parallel_decode_into(NULL, &size, buf, 1024, encoded_str, length, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_parallel_decode_into(pool, &size, buf, 1024, encoded_str, length, &b64_std_alphabet, true));
+
+    FREE_NULL(encoded_str);
+    FREE_NULL(buf);
+    b64_thread_pool_destroy(pool);
+    FREE_NULL(input_bytes);
+}
+
+void test_decoding_in_batch(void) {
+    B64Span srcs[] = {
+        { ALL_B64_CHARS, strlen(ALL_B64_CHARS) },
+        { "", 0 },
+        { "QUI=", 4 },
+        { "QUJD\r\nQQ", 8 },
+        { "QQ==", 4 }
+    };
+    const size_t num_srcs = sizeof(srcs) / sizeof(srcs[0]);
+
+    size_t offsets[6];
+    const size_t buf_size = b64_get_batch_decoded_size(srcs, num_srcs);
+    uint8_t* buf = malloc(buf_size);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_batch(offsets, buf, buf_size, srcs, num_srcs, &b64_std_alphabet, true));
+
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_ALL_B64_CHARS), offsets[1] - offsets[0]);
+    ASSERT_MEM_EQ(BYTES_OF_ALL_B64_CHARS, &buf[offsets[0]], sizeof(BYTES_OF_ALL_B64_CHARS));
+    ASSERT_SIZE_EQ(0, offsets[2] - offsets[1]);
+    uint8_t exp_bytes[] = { 'A', 'B', 'A', 'B', 'C', 'A' };
+    ASSERT_SIZE_EQ(2, offsets[3] - offsets[2]);
+    ASSERT_MEM_EQ(exp_bytes, &buf[offsets[2]], 2);
+    ASSERT_SIZE_EQ(4, offsets[4] - offsets[3]);
+    ASSERT_MEM_EQ(&exp_bytes[2], &buf[offsets[3]], 4);
+    ASSERT_SIZE_EQ(1, offsets[5] - offsets[4]);
+    ASSERT_MEM_EQ(&exp_bytes[5], &buf[offsets[4]], 1);
+
+    // Only padding or linebreaks are not decoded to an empty byte array, unlike an empty input
+    srcs[4] = (B64Span){ "==", 2 };
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64_decode_batch(offsets, buf, buf_size, srcs, num_srcs, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_ALL_B64_CHARS) + 6, offsets[4]);
+    srcs[4] = (B64Span){ "\r\n", 2 };
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64_decode_batch(offsets, buf, buf_size, srcs, num_srcs, &b64_std_alphabet, true));
+    srcs[4] = (B64Span){ "QQ==", 4 };
+
+    // Decoding stops at the invalid input
+    srcs[2].data = "QU!=";
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_batch(offsets, buf, buf_size, srcs, num_srcs, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_ALL_B64_CHARS), offsets[2]);
+
+    ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_decode_batch(offsets, buf, 47, srcs, num_srcs, &b64_std_alphabet, true));
+
+    FREE_NULL(buf);
+}
+
+void test_decoding_small(void) {
+    uint8_t input_bytes[B64_SMALL_MAX_SIZE];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    uint8_t buf[B64_SMALL_MAX_SIZE];
+    for (size_t src_size = 1; src_size <= B64_SMALL_MAX_SIZE; ++src_size) {
+        for (int padding = 0; padding <= 1; ++padding) {
+            const B64Alphabet* alphabet = padding ? &b64_std_alphabet : &b64_url_alphabet;
+            size_t length;
+            char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, src_size, alphabet, padding, 0);
+
+            size_t size;
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_small(&size, buf, src_size, encoded_str, length, alphabet));
+            ASSERT_SIZE_EQ(src_size, size);
+            ASSERT_MEM_EQ(input_bytes, buf, size);
+
+            ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_decode_small(&size, buf, src_size - 1, encoded_str, length, alphabet));
+
+            // Invalid character checked after all blocks are decoded
+            encoded_str[0] = '!';
+            ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_small(&size, buf, src_size, encoded_str, length, alphabet));
+            FREE_NULL(encoded_str);
+        }
+    }
+
+    size_t size;
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_small(&size, buf, sizeof(buf), "QUJD\r\nREVG", 10, &b64_std_alphabet));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, b64_decode_small(&size, buf, sizeof(buf), "QUJDR", 5, &b64_std_alphabet));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64_decode_small(&size, buf, sizeof(buf), "==", 2, &b64_std_alphabet));
+
+    char long_str[B64_SMALL_MAX_LENGTH + 5];
+    memset(long_str, 'A', sizeof(long_str));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, b64_decode_small(&size, buf, sizeof(buf), long_str, sizeof(long_str), &b64_std_alphabet));
+
+    // The general decoding into the buffer takes over the input not handled by the small decoding
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_n(&size, buf, sizeof(buf), "QUJD\r\nREVG", 10, &b64_std_alphabet, true));
+    ASSERT_MEM_EQ((uint8_t*)"ABCDEF", buf, 6);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_n(&size, buf, sizeof(buf), "QUI=QUJD", 8, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(2, size);
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_into_n(&size, buf, sizeof(buf), "QUJD!EVG", 8, &b64_std_alphabet, true));
+}
+
+void test_decoding_in_place(void) {
+    char str[] = "QUJDREVGRw==";
+    size_t size;
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_in_place(&size, str, &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(7, size);
+    ASSERT_MEM_EQ((uint8_t*)"ABCDEFG", (uint8_t*)str, size);
+
+    const size_t input_size = 10000;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    for (size_t line_length = 0; line_length <= B64_MIME_LINE_LENGTH; line_length += B64_MIME_LINE_LENGTH) {
+        for (size_t src_size = 1; src_size <= input_size; src_size = src_size * 3 + 1) {
+            size_t length;
+            char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, src_size, &b64_std_alphabet, true, line_length);
+
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_in_place_n(&size, encoded_str, length, &b64_std_alphabet, true));
+            ASSERT_SIZE_EQ(src_size, size);
+            ASSERT_MEM_EQ(input_bytes, (uint8_t*)encoded_str, size);
+
+            FREE_NULL(encoded_str);
+        }
+    }
+
+    // Whitespaces are skipped without validation
+    size_t length;
+    char* encoded_str = b64_std_encode(&length, input_bytes, input_size);
+    for (size_t i = 0; i < length; i += 61) {
+        encoded_str[i] = ' ';
+    }
+    size_t exp_size;
+    uint8_t* exp_bytes = b64_decode_with_alphabet_n(&exp_size, encoded_str, length, &b64_std_alphabet, false);
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_in_place(&size, encoded_str, &b64_std_alphabet, true));
+    FREE_NULL(encoded_str);
+
+    encoded_str = b64_std_encode(&length, input_bytes, input_size);
+    for (size_t i = 0; i < length; i += 61) {
+        encoded_str[i] = ' ';
+    }
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_in_place(&size, encoded_str, &b64_std_alphabet, false));
+    ASSERT_SIZE_EQ(exp_size, size);
+    ASSERT_MEM_EQ(exp_bytes, (uint8_t*)encoded_str, size);
+
+    FREE_NULL(exp_bytes);
+    FREE_NULL(encoded_str);
+    FREE_NULL(input_bytes);
+}
+
+void test_decoding_with_digest(void) {
+    const size_t input_size = 10000;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+    uint8_t* buf = malloc(input_size);
+
+    for (size_t line_length = 0; line_length <= B64_MIME_LINE_LENGTH; line_length += B64_MIME_LINE_LENGTH) {
+        for (size_t src_size = 1; src_size <= input_size; src_size = src_size * 3 + 1) {
+            size_t length;
+            char* encoded_str = b64_encode_with_alphabet(&length, input_bytes, src_size, &b64_std_alphabet, true, line_length);
+
+            size_t size;
+            B64Digest digest;
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_with_digest(&size, buf, input_size, encoded_str, &b64_std_alphabet, true, B64_DIGEST_CRC32C | B64_DIGEST_XXH64, &digest));
+            ASSERT_SIZE_EQ(src_size, size);
+            ASSERT_MEM_EQ(input_bytes, buf, size);
+            ASSERT_SIZE_EQ(b64_crc32c(0, input_bytes, src_size), digest.crc32c);
+            ASSERT_SIZE_EQ(b64_xxh64(input_bytes, src_size, 0), digest.xxh64);
+
+            ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_with_digest_n(&size, buf, input_size, encoded_str, length, &b64_std_alphabet, true, B64_DIGEST_CRC32C, &digest));
+            ASSERT_SIZE_EQ(src_size, size);
+            ASSERT_SIZE_EQ(b64_crc32c(0, input_bytes, src_size), digest.crc32c);
+            ASSERT_SIZE_EQ(0, digest.xxh64);
+
+            FREE_NULL(encoded_str);
+        }
+    }
+
+    // Invalid character after the first chunk
+    size_t length;
+    char* encoded_str = b64_std_encode(&length, input_bytes, input_size);
+    encoded_str[length - 10] = '!';
+    size_t size;
+    B64Digest digest;
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_into_with_digest(&size, buf, input_size, encoded_str, &b64_std_alphabet, true, B64_DIGEST_CRC32C, &digest));
+    FREE_NULL(encoded_str);
+
+    FREE_NULL(buf);
+    FREE_NULL(input_bytes);
+}
+
+void test_decoding_strict(void) {
+    size_t size;
+    uint8_t buf[16];
+
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRw==", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(7, size);
+    ASSERT_MEM_EQ((uint8_t*)"ABCDEFG", buf, size);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_strict(&size, buf, sizeof(buf), "QUI=", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(2, size);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJD", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(3, size);
+
+    // Missing, excess or misplaced padding
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRw", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRw=", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRw===", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QUI==", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QU==QUJD", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJD====", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "Q===", &b64_std_alphabet, true));
+
+    // Non-zero unused bits
+    ASSERT_SIZE_EQ(B64_ERROR_NON_ZERO_TRAILING_BITS, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRx==", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_NON_ZERO_TRAILING_BITS, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJ=", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into(&size, buf, sizeof(buf), "QUJ=", &b64_std_alphabet, true));
+
+    // Linebreaks and invalid characters
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJD\r\nREVG", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_into_strict(&size, buf, sizeof(buf), "QUI=\r\n", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDR", &b64_std_alphabet, false));
+
+    // Padding is prohibited without padding
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRw", &b64_url_alphabet, false));
+    ASSERT_SIZE_EQ(7, size);
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_PADDING, b64_decode_into_strict(&size, buf, sizeof(buf), "QUJDREVGRw==", &b64_url_alphabet, false));
+
+    // Outputs of the encoding are accepted
+    const size_t input_size = 1000;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+    for (size_t src_size = 1; src_size <= input_size; src_size = src_size * 2 + 1) {
+        size_t length;
+        char* encoded_str = b64_url_encode(&length, input_bytes, src_size);
+        uint8_t* decoded_bytes = b64_decode_strict_n(&size, encoded_str, length, &b64_url_alphabet, false);
+        ASSERT_SIZE_EQ(src_size, size);
+        ASSERT_MEM_EQ(input_bytes, decoded_bytes, size);
+        FREE_NULL(decoded_bytes);
+        FREE_NULL(encoded_str);
+
+        encoded_str = b64_std_encode(&length, input_bytes, src_size);
+        decoded_bytes = b64_decode_strict(&size, encoded_str, &b64_std_alphabet, true);
+        ASSERT_SIZE_EQ(src_size, size);
+        ASSERT_MEM_EQ(input_bytes, decoded_bytes, size);
+        FREE_NULL(decoded_bytes);
+        FREE_NULL(encoded_str);
+    }
+    FREE_NULL(input_bytes);
+
+    // Padding split into the chunks of the stream
+    B64DecodeState state;
+    b64_decode_init_strict(&state, &b64_std_alphabet, true);
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_update(&state, &size, buf, sizeof(buf), "QUJDQQ=", 7));
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_update(&state, &size, buf, sizeof(buf), "=", 1));
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64_decode_final(&state, &size, buf, sizeof(buf)));
+    ASSERT_SIZE_EQ(1, size);
+    ASSERT_SIZE_EQ('A', buf[0]);
+}
+
+void test_getting_decoded_size(void) {
+    // Without linebreaks in O(1)
+    ASSERT_SIZE_EQ(7, b64_get_decoded_size_unwrapped("QUJDREVGRw==", 12));
+    ASSERT_SIZE_EQ(7, b64_get_decoded_size_unwrapped("QUJDREVGRw", 10));
+    ASSERT_SIZE_EQ(2, b64_get_decoded_size_unwrapped("QUI=", 4));
+    ASSERT_SIZE_EQ(3, b64_get_decoded_size_unwrapped("QUJD", 4));
+    ASSERT_SIZE_EQ(0, b64_get_decoded_size_unwrapped("QUJDR", 5));
+    ASSERT_SIZE_EQ(0, b64_get_decoded_size_unwrapped("==", 2));
+    ASSERT_SIZE_EQ(0, b64_get_decoded_size_unwrapped("====", 4));
+    ASSERT_SIZE_EQ(0, b64_get_decoded_size_unwrapped("Q===", 4));
+    // Padding in the middle is not detected, the size is an upper bound of the decoded size (1)
+    ASSERT_SIZE_EQ(4, b64_get_decoded_size_unwrapped("QQ==QQ==", 8));
+    ASSERT_SIZE_EQ(0, b64_get_decoded_size_unwrapped("", 0));
+
+    // Counted with linebreaks, same as the size of the encoding input
+    const size_t input_size = 10000;
+    uint8_t* input_bytes = malloc(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+    for (size_t src_size = 1; src_size <= input_size; src_size = src_size * 3 + 1) {
+        size_t length;
+        char* encoded_str = b64_mime_encode(&length, input_bytes, src_size);
+        ASSERT_SIZE_EQ(src_size, b64_get_decoded_size_n(encoded_str, length, &b64_std_alphabet));
+        FREE_NULL(encoded_str);
+
+        encoded_str = b64_url_encode(&length, input_bytes, src_size);
+        ASSERT_SIZE_EQ(src_size, b64_get_decoded_size_unwrapped(encoded_str, length));
+        ASSERT_SIZE_EQ(src_size, b64_get_decoded_size(encoded_str, &b64_url_alphabet));
+        FREE_NULL(encoded_str);
+    }
+    FREE_NULL(input_bytes);
+
+    // The characters after the padding are not counted
+    char long_str[] = "QUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUI=QUJDQUJD";
+    ASSERT_SIZE_EQ(44, b64_get_decoded_size(long_str, &b64_std_alphabet));
+}
+
+void test_decoding_with_error(void) {
+    size_t size;
+    B64Error error;
+
+    uint8_t* decoded_bytes = b64_decode_with_error(&size, "QUJDREVGRw==", &b64_std_alphabet, true, &error);
+    ASSERT_SIZE_EQ(B64_SUCCESS, error.code);
+    ASSERT_SIZE_EQ(12, error.offset);
+    ASSERT_SIZE_EQ(7, error.decoded_size);
+    ASSERT_SIZE_EQ(7, size);
+    ASSERT_MEM_EQ((uint8_t*)"ABCDEFG", decoded_bytes, size);
+    FREE_NULL(decoded_bytes);
+
+    // Offset of the invalid character and the bytes decoded before it
+    ASSERT_NULL(b64_decode_with_error(&size, "QUJD\r\nREVG!w==", &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, error.code);
+    ASSERT_SIZE_EQ(10, error.offset);
+    ASSERT_SIZE_EQ(6, error.decoded_size);
+
+    // Invalid character found by the SIMD decoding
+    char long_str[] = "QUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJDQUJD?UJD";
+    ASSERT_NULL(b64_decode_with_error(&size, long_str, &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, error.code);
+    ASSERT_SIZE_EQ(60, error.offset);
+    ASSERT_SIZE_EQ(45, error.decoded_size);
+
+    // Errors at the end of the input
+    ASSERT_NULL(b64_decode_with_error(&size, "QUJDR", &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, error.code);
+    ASSERT_SIZE_EQ(5, error.offset);
+    ASSERT_SIZE_EQ(3, error.decoded_size);
+
+    ASSERT_NULL(b64_decode_with_error(&size, "Q", &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, error.code);
+    ASSERT_SIZE_EQ(1, error.offset);
+
+    ASSERT_NULL(b64_decode_with_error(&size, "!", &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, error.code);
+    ASSERT_SIZE_EQ(0, error.offset);
+
+    ASSERT_NULL(b64_decode_with_error(&size, "", &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, error.code);
+
+    ASSERT_NULL(b64_decode_with_error_n(&size, "\r\n", 2, &b64_std_alphabet, true, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, error.code);
+    ASSERT_SIZE_EQ(2, error.offset);
+
+    ASSERT_STR_EQ("invalid character", b64_result_string(B64_ERROR_INVALID_CHAR));
+    ASSERT_STR_EQ("out of memory", b64_result_string(B64_ERROR_OUT_OF_MEMORY));
+}
+
+void test_decoding_fails_with_non_encoding_char_in_long_string(void) {
+    uint8_t input_bytes[120];
+    for (size_t i = 0; i < sizeof(input_bytes); ++i) {
+        input_bytes[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    char encoded_str[161];
+    encode_for_reference(encoded_str, input_bytes, sizeof(input_bytes), ALL_B64_CHARS, true);
+
+    size_t size;
+    for (size_t i = 0; i < 160; i += 7) {
+        char original_char = encoded_str[i];
+
+        encoded_str[i] = '?';
+        ASSERT_NULL(b64_std_decode(&size, encoded_str));
+
+        // Insert a non-encoding character instead of replacing
+        char mime_str[162];
+        memcpy(mime_str, encoded_str, i);
+        mime_str[i] = '?';
+        mime_str[i + 1] = original_char;
+        strcpy(&mime_str[i + 2], &encoded_str[i + 1]);
+
+        uint8_t* output_bytes = b64_mime_decode(&size, mime_str);
+        ASSERT_SIZE_EQ(sizeof(input_bytes), size);
+        ASSERT_MEM_EQ(input_bytes, output_bytes, size);
+        FREE_NULL(output_bytes);
+
+        encoded_str[i] = original_char;
+    }
+}
+
+void test_decoding_with_arena(void) {
+    // Room for a decoded byte array of 48 bytes
+    const size_t arena_size = 64;
+    uint8_t* arena_buf = malloc(arena_size);
+    B64Arena arena;
+    b64_arena_init(&arena, arena_buf, arena_size);
+    B64Allocator allocator = b64_arena_allocator(&arena);
+
+    size_t size;
+    uint8_t* output_bytes = b64_decode_with_allocator(&size, ALL_B64_CHARS, &b64_std_alphabet, true, &allocator);
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_ALL_B64_CHARS), size);
+    ASSERT_MEM_EQ(BYTES_OF_ALL_B64_CHARS, output_bytes, size);
+    const size_t used = arena.used;
+
+    // Memory is returned to the arena when decoding failed
+    ASSERT_NULL(b64_decode_with_allocator_n(&size, "QUJD!", 5, &b64_std_alphabet, true, &allocator));
+    ASSERT_SIZE_EQ(used, arena.used);
+
+    // Fails when the rest of the arena is not enough
+    ASSERT_NULL(b64_decode_with_allocator(&size, ALL_B64_CHARS, &b64_std_alphabet, true, &allocator));
+
+    // Strict decoding and the detail of an error by the arena
+    b64_arena_reset(&arena);
+    output_bytes = b64_decode_strict_with_allocator(&size, "QUI=", &b64_std_alphabet, true, &allocator);
+    ASSERT_SIZE_EQ(2, size);
+    ASSERT_MEM_EQ((uint8_t*)"AB", output_bytes, size);
+    ASSERT_NULL(b64_decode_strict_with_allocator_n(&size, "QUJ=", 4, &b64_std_alphabet, true, &allocator));
+
+    char long_str[129];
+    memset(long_str, 'A', 128);
+    long_str[128] = '\0';
+    B64Error error;
+    ASSERT_NULL(b64_decode_with_allocator_and_error(&size, long_str, &b64_std_alphabet, true, &allocator, &error));
+    ASSERT_SIZE_EQ(B64_ERROR_OUT_OF_MEMORY, error.code);
+    output_bytes = b64_decode_with_allocator_and_error_n(&size, "QUJD", 4, &b64_std_alphabet, true, &allocator, &error);
+    ASSERT_SIZE_EQ(B64_SUCCESS, error.code);
+    ASSERT_MEM_EQ((uint8_t*)"ABC", output_bytes, 3);
+
+    FREE_NULL(arena_buf);
+}
+
+void test_decoding_into_buffer(void) {
+    size_t buf_size = b64_get_decoded_size(B64_CHARS_OVER_76_CHARS_WITH_CRLF, &b64_std_alphabet);
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_B64_CHARS_OVER_76_CHARS), buf_size);
+
+    uint8_t buf[64];
+    size_t size;
+
+    B64Result result = b64_decode_into(&size, buf, buf_size, B64_CHARS_OVER_76_CHARS_WITH_CRLF, &b64_std_alphabet, false);
+    ASSERT_SIZE_EQ(B64_SUCCESS, result);
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_B64_CHARS_OVER_76_CHARS), size);
+    ASSERT_MEM_EQ(BYTES_OF_B64_CHARS_OVER_76_CHARS, buf, size);
+
+    result = b64_decode_into(&size, buf, sizeof(buf), ALL_B64_CHARS_URL_SAFE, &b64_url_alphabet, true);
+    ASSERT_SIZE_EQ(B64_SUCCESS, result);
+    ASSERT_SIZE_EQ(sizeof(BYTES_OF_ALL_B64_CHARS), size);
+    ASSERT_MEM_EQ(BYTES_OF_ALL_B64_CHARS, buf, size);
+}
+
+void test_decoding_into_buffer_fails(void) {
+    uint8_t buf[3];
+    size_t size;
+
+    ASSERT_SIZE_EQ(B64_ERROR_BUFFER_TOO_SMALL, b64_decode_into(&size, buf, 1, "//8=", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64_decode_into(&size, buf, sizeof(buf), "", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, b64_decode_into(&size, buf, sizeof(buf), "/===", &b64_std_alphabet, true));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64_decode_into(&size, buf, sizeof(buf), "ABC?", &b64_std_alphabet, true));
+}
+
 void test_decoding_fails_when_input_size_is_0(void) {
     char input_b64_chars[] = "";
 
@@ -331,6 +1408,85 @@ void test_decoding_fails_with_non_encoding_char(void) {
     ASSERT_NULL(b64_url_decode(&size, input_b64_chars));
 }
 
+// Encode/decode in another thread, which exits before the snapshot
+static void* encode_decode_in_thread(void* arg) {
+    (void)arg;
+    size_t length;
+    char* encoded_str = b64_url_encode(&length, "ABCD", 4);
+    size_t size;
+    void* decoded_bytes = b64_url_decode(&size, encoded_str);
+    free(decoded_bytes);
+    free(encoded_str);
+    return NULL;
+}
+
+// Sum of the latency histogram
+static uint64_t sum_latency_histogram(const B64EntryStats* stats) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < B64_STATS_NUM_LATENCY_BUCKETS; ++i) {
+        sum += stats->latency_histogram[i];
+    }
+    return sum;
+}
+
+void test_stats(void) {
+    ASSERT_STR_EQ("b64_mime_decode", b64_stats_entry_name(B64_STATS_MIME_DECODE));
+
+    B64Stats stats;
+    b64_stats_reset();
+    if (!b64_stats_snapshot(&stats)) {
+        // Not recorded without B64_STATS
+        ASSERT_SIZE_EQ(0, stats.entries[B64_STATS_STD_ENCODE].num_calls);
+        return;
+    }
+
+    size_t length;
+    char* encoded_str = b64_std_encode(&length, "ABCDEFG", 7);
+    FREE_NULL(encoded_str);
+    ASSERT_NULL(b64_std_encode(&length, "", 0));
+
+    size_t size;
+    void* decoded_bytes = b64_std_decode(&size, "QUJDREVGRw==");
+    FREE_NULL(decoded_bytes);
+    ASSERT_NULL(b64_std_decode(&size, "QU?D"));
+    ASSERT_NULL(b64_std_decode(&size, "Q"));
+    ASSERT_NULL(b64_decode(&size, "QUJD", (char[]){'+', '+'}, true));
+
+    pthread_t thread;
+    ASSERT_SIZE_EQ(0, pthread_create(&thread, NULL, encode_decode_in_thread, NULL));
+    pthread_join(thread, NULL);
+
+    ASSERT_TRUE(b64_stats_snapshot(&stats));
+
+    const B64EntryStats* encode_stats = &stats.entries[B64_STATS_STD_ENCODE];
+    ASSERT_SIZE_EQ(2, encode_stats->num_calls);
+    ASSERT_SIZE_EQ(7, encode_stats->input_size);
+    ASSERT_SIZE_EQ(12, encode_stats->output_size);
+    ASSERT_SIZE_EQ(1, encode_stats->num_results[B64_SUCCESS]);
+    ASSERT_SIZE_EQ(1, encode_stats->num_results[B64_ERROR_EMPTY_INPUT]);
+    ASSERT_SIZE_EQ(2, sum_latency_histogram(encode_stats));
+
+    const B64EntryStats* decode_stats = &stats.entries[B64_STATS_STD_DECODE];
+    ASSERT_SIZE_EQ(3, decode_stats->num_calls);
+    ASSERT_SIZE_EQ(12 + 4 + 1, decode_stats->input_size);
+    ASSERT_SIZE_EQ(7, decode_stats->output_size);
+    ASSERT_SIZE_EQ(1, decode_stats->num_results[B64_SUCCESS]);
+    ASSERT_SIZE_EQ(1, decode_stats->num_results[B64_ERROR_INVALID_CHAR]);
+    ASSERT_SIZE_EQ(1, decode_stats->num_results[B64_ERROR_INVALID_LENGTH]);
+
+    ASSERT_SIZE_EQ(1, stats.entries[B64_STATS_DECODE].num_results[B64_ERROR_INVALID_ARGUMENT]);
+
+    // Kept after the thread exited
+    ASSERT_SIZE_EQ(1, stats.entries[B64_STATS_URL_ENCODE].num_calls);
+    ASSERT_SIZE_EQ(6, stats.entries[B64_STATS_URL_ENCODE].output_size);
+    ASSERT_SIZE_EQ(1, stats.entries[B64_STATS_URL_DECODE].num_results[B64_SUCCESS]);
+
+    b64_stats_reset();
+    ASSERT_TRUE(b64_stats_snapshot(&stats));
+    ASSERT_SIZE_EQ(0, stats.entries[B64_STATS_STD_ENCODE].num_calls);
+    ASSERT_SIZE_EQ(0, stats.entries[B64_STATS_URL_DECODE].num_calls);
+}
+
 int main(void) {
     ADD_TEST_CASE(test_encoding_all_b64_chars);
     ADD_TEST_CASE(test_encoding_2bytes_input);
@@ -341,6 +1497,19 @@ int main(void) {
 
     ADD_TEST_CASE(test_encoding_by_specified_line_length);
     ADD_TEST_CASE(test_encoding_with_specified_chars);
+    ADD_TEST_CASE(test_encoding_with_alphabet);
+
+    ADD_TEST_CASE(test_encoding_various_sizes);
+
+    ADD_TEST_CASE(test_encoding_by_stream);
+    ADD_TEST_CASE(test_encoding_in_parallel);
+    ADD_TEST_CASE(test_encoding_in_batch);
+    ADD_TEST_CASE(test_encoding_small);
+    ADD_TEST_CASE(test_encoding_with_digest);
+
+    ADD_TEST_CASE(test_encoding_with_arena);
+    ADD_TEST_CASE(test_encoding_into_buffer);
+    ADD_TEST_CASE(test_encoding_into_buffer_fails);
 
     ADD_TEST_CASE(test_encoding_fails_when_input_size_is_0);
 
@@ -352,11 +1521,35 @@ int main(void) {
     ADD_TEST_CASE(test_mime_decoding_with_non_encoding_char);
 
     ADD_TEST_CASE(test_decoding_with_specified_chars);
+    ADD_TEST_CASE(test_decoding_with_alphabet);
+    ADD_TEST_CASE(test_alphabet_init_same_as_predefined);
+    ADD_TEST_CASE(test_alphabet_init_fails_with_invalid_chars);
+
+    ADD_TEST_CASE(test_decoding_various_sizes);
+    ADD_TEST_CASE(test_mime_decoding_long_lines);
+    ADD_TEST_CASE(test_decoding_by_stream);
+    ADD_TEST_CASE(test_decoding_in_parallel);
+    ADD_TEST_CASE(test_decoding_in_batch);
+    ADD_TEST_CASE(test_decoding_small);
+    ADD_TEST_CASE(test_decoding_in_place);
+    ADD_TEST_CASE(test_decoding_with_digest);
+    ADD_TEST_CASE(test_decoding_fails_with_non_encoding_char_in_long_string);
+    ADD_TEST_CASE(test_getting_decoded_size);
+    ADD_TEST_CASE(test_decoding_with_error);
+    ADD_TEST_CASE(test_decoding_strict);
+    ADD_TEST_CASE(test_decoding_finishes_at_padding);
+    ADD_TEST_CASE(test_decoding_with_length);
+
+    ADD_TEST_CASE(test_decoding_with_arena);
+    ADD_TEST_CASE(test_decoding_into_buffer);
+    ADD_TEST_CASE(test_decoding_into_buffer_fails);
 
     ADD_TEST_CASE(test_decoding_fails_when_input_size_is_0);
     ADD_TEST_CASE(test_decoding_fails_less_than_1byte);
     ADD_TEST_CASE(test_decoding_fails_with_non_encoding_char);
 
+    ADD_TEST_CASE(test_stats);
+
     run_all_tests();
 
     return 0;
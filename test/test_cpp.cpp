@@ -0,0 +1,135 @@
+#include "b64.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
+
+void test_encoding_append(void) {
+    std::string out = "data:";
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64::encode_append(out, "ABCDEFG"));
+    ASSERT_STR_EQ("data:QUJDREVGRw==", out.c_str());
+
+    // Appended after the existing string
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64::encode_append(out, std::string_view("AB"), b64::url_encoding));
+    ASSERT_STR_EQ("data:QUJDREVGRw==QUI", out.c_str());
+
+    // Unchanged on failure
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64::encode_append(out, ""));
+    ASSERT_STR_EQ("data:QUJDREVGRw==QUI", out.c_str());
+
+    // Same as the C API with linebreaks
+    std::vector<std::uint8_t> input_bytes(1000);
+    for (std::size_t i = 0; i < input_bytes.size(); ++i) {
+        input_bytes[i] = static_cast<std::uint8_t>(i * 167 + 13);
+    }
+    std::size_t length;
+    char* exp_str = b64_mime_encode(&length, input_bytes.data(), input_bytes.size());
+    std::vector<char> chars;
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64::encode_append(chars, input_bytes.data(), input_bytes.size(), b64::mime_encoding));
+    ASSERT_SIZE_EQ(length, chars.size());
+    ASSERT_MEM_EQ(reinterpret_cast<std::uint8_t*>(exp_str), reinterpret_cast<std::uint8_t*>(chars.data()), length);
+    std::free(exp_str);
+
+    std::optional<std::string> encoded = b64::encode("ABC");
+    ASSERT_TRUE(encoded.has_value());
+    ASSERT_STR_EQ("QUJD", encoded->c_str());
+
+#ifdef B64_HAS_SPAN
+    const std::byte bytes[] = { std::byte{ 0xf3 }, std::byte{ 0xdf }, std::byte{ 0xbf } };
+    encoded = b64::encode(std::span<const std::byte>(bytes), b64::url_encoding);
+    ASSERT_TRUE(encoded.has_value());
+    ASSERT_STR_EQ("89-_", encoded->c_str());
+#endif
+}
+
+void test_decoding_append(void) {
+    std::vector<std::byte> out(1, std::byte{ 0xff });
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64::decode_append(out, "QUJDREVGRw=="));
+    ASSERT_SIZE_EQ(8, out.size());
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("\xff" "ABCDEFG"), reinterpret_cast<std::uint8_t*>(out.data()), 8);
+
+    // Unchanged on failure
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_CHAR, b64::decode_append(out, "QU!D"));
+    ASSERT_SIZE_EQ(8, out.size());
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64::decode_append(out, ""));
+    ASSERT_SIZE_EQ(B64_ERROR_EMPTY_INPUT, b64::decode_append(out, std::string_view()));
+    ASSERT_SIZE_EQ(B64_ERROR_INVALID_LENGTH, b64::decode_append(out, "Q"));
+    ASSERT_SIZE_EQ(8, out.size());
+
+    std::string str;
+    ASSERT_SIZE_EQ(B64_SUCCESS, b64::decode_append(str, "QUJD\r\nRA", b64::mime_decoding));
+    ASSERT_STR_EQ("ABCD", str.c_str());
+
+    std::optional<std::vector<std::uint8_t>> decoded = b64::decode<std::vector<std::uint8_t>>("89-_", b64::url_decoding);
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_SIZE_EQ(3, decoded->size());
+    ASSERT_SIZE_EQ(0xbf, (*decoded)[2]);
+
+    ASSERT_FALSE(b64::decode<std::string>("89-_").has_value());
+}
+
+void test_compile_time_encoding(void) {
+    constexpr std::array<char, 12> encoded = b64::encode_array("ABCDEFG");
+    static_assert(encoded[10] == '=');
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("QUJDREVGRw=="), reinterpret_cast<const std::uint8_t*>(encoded.data()), encoded.size());
+
+    constexpr auto url_encoded = b64::encode_array<false>(std::array<std::uint8_t, 4>{ 0xf3, 0xdf, 0xbf, 0xfe }, b64::url_encoding_chars);
+    static_assert(url_encoded.size() == 6);
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("89-__g"), reinterpret_cast<const std::uint8_t*>(url_encoded.data()), url_encoded.size());
+
+    // Same as the C API
+    constexpr auto all_encoded = b64::encode_array(
+        "\x00\x10\x83\x10\x51\x87\x20\x92\x8b\x30\xd3\x8f\x41\x14\x93\x51\x55\x97"
+        "\x61\x96\x9b\x71\xd7\x9f\x82\x18\xa3\x92\x59\xa7\xa2\x9a\xab\xb2\xdb\xaf"
+        "\xc3\x1c\xb3\xd3\x5d\xb7\xe3\x9e\xbb\xf3\xdf\xbf");
+    std::size_t length;
+    char* exp_str = b64_std_encode(&length, "\x00\x10\x83\x10\x51\x87\x20\x92\x8b\x30\xd3\x8f\x41\x14\x93\x51\x55\x97"
+        "\x61\x96\x9b\x71\xd7\x9f\x82\x18\xa3\x92\x59\xa7\xa2\x9a\xab\xb2\xdb\xaf"
+        "\xc3\x1c\xb3\xd3\x5d\xb7\xe3\x9e\xbb\xf3\xdf\xbf", 48);
+    ASSERT_SIZE_EQ(length, all_encoded.size());
+    ASSERT_MEM_EQ(reinterpret_cast<std::uint8_t*>(exp_str), reinterpret_cast<const std::uint8_t*>(all_encoded.data()), length);
+    std::free(exp_str);
+}
+
+void test_compile_time_decoding(void) {
+    static_assert(b64::get_decoded_size("QUJDREVGRw==") == 7);
+    static_assert(b64::get_decoded_size("QUJDREVGRw") == 7);
+    static_assert(b64::get_decoded_size("89-_", b64::url_encoding_chars) == 3);
+
+    constexpr std::array<std::uint8_t, 7> decoded = b64::decode_array<7>("QUJDREVGRw==");
+    static_assert(decoded[6] == 'G');
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("ABCDEFG"), decoded.data(), decoded.size());
+
+    constexpr auto decoded_no_padding = b64::decode_array<b64::get_decoded_size("QUJDREU")>("QUJDREU");
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("ABCDE"), decoded_no_padding.data(), decoded_no_padding.size());
+
+    // Round trip
+    constexpr auto round_trip = b64::decode_array<3>("89-_", b64::url_encoding_chars);
+    constexpr auto re_encoded = b64::encode_array(round_trip, b64::url_encoding_chars);
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("89-_"), reinterpret_cast<const std::uint8_t*>(re_encoded.data()), re_encoded.size());
+
+#ifdef B64_HAS_LITERAL_OPERATOR
+    using namespace b64::literals;
+    constexpr auto bytes = "QUJDREVGRw=="_b64;
+    static_assert(bytes.size() == 7);
+    ASSERT_MEM_EQ(reinterpret_cast<const std::uint8_t*>("ABCDEFG"), bytes.data(), bytes.size());
+
+    constexpr auto url_bytes = "89-_"_b64url;
+    static_assert((url_bytes.size() == 3) && (url_bytes[2] == 0xbf));
+#endif
+}
+
+int main(void) {
+    ADD_TEST_CASE(test_encoding_append);
+    ADD_TEST_CASE(test_decoding_append);
+    ADD_TEST_CASE(test_compile_time_encoding);
+    ADD_TEST_CASE(test_compile_time_decoding);
+
+    run_all_tests();
+
+    return 0;
+}
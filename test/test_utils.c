@@ -108,6 +108,15 @@ bool assert_mem_eq(const uint8_t *expected, const uint8_t *actual, const size_t
     return true;
 }
 
+bool assert_bool_eq(const bool expected, const bool actual, const char* file, const int line) {
+    if (expected != actual) {
+        fprintf(stderr, "FAIL: expected %s was %s, %s line %d\n", expected ? "true" : "false", actual ? "true" : "false", file, line);
+        set_current_test_case_failed();
+        return false;
+    }
+    return true;
+}
+
 bool assert_null(void* ptr, const char* file, const int line) {
     if (ptr != NULL) {
         fprintf(stderr, "FAIL: %p is not NULL, %p, %s line %d", ptr, ptr, file, line);
@@ -5,6 +5,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Max number of the test cases
 #define MAX_NUM_TEST_CASES 100
 
@@ -26,9 +30,16 @@ bool assert_str_eq(const char *expected, const char *actual, const char* file, c
 // Check equality of byte array
 bool assert_mem_eq(const uint8_t *expected, const uint8_t *actual, const size_t size, const char* file, const int line);
 
+// Check the boolean value
+bool assert_bool_eq(const bool expected, const bool actual, const char* file, const int line);
+
 // Check the pointer is NULL
 bool assert_null(void* ptr, const char* file, const int line);
 
+#ifdef __cplusplus
+}
+#endif
+
 /**********************/
 // Test utility macros
 /**********************/
@@ -58,6 +69,20 @@ bool assert_null(void* ptr, const char* file, const int line);
     } \
 }
 
+// Check the condition is true and return when it was false
+#define ASSERT_TRUE(cond) { \
+    if (!assert_bool_eq(true, (cond), __FILE__, __LINE__)) { \
+        return; \
+    } \
+}
+
+// Check the condition is false and return when it was true
+#define ASSERT_FALSE(cond) { \
+    if (!assert_bool_eq(false, (cond), __FILE__, __LINE__)) { \
+        return; \
+    } \
+}
+
 #define ASSERT_NULL(ptr) { \
     if (!assert_null((ptr), __FILE__, __LINE__)) { \
         return; \
@@ -0,0 +1,320 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "b64.h"
+
+// Byte size of the input mapped and processed at once, a multiple of the page size
+#define CHUNK_SIZE (3 * 256 * 1024)
+
+// Options of the command line
+typedef struct Options_tag {
+    bool decoding;
+    const B64Alphabet* alphabet;
+    bool use_padding;
+    size_t line_length;
+    bool validate;
+    bool quiet;
+    const char* input_name;
+    const char* output_name;
+} Options;
+
+// Input file mapped on memory chunk by chunk
+typedef struct InputFile_tag {
+    int fd;
+    size_t size;
+} InputFile;
+
+static void print_usage(const char* name) {
+    fprintf(stderr,
+        "usage: %s [-d] [-u] [-m] [-w line_length] [-i] [-q] input_file [output_file]\n"
+        "  -d  decode the input (encode by default)\n"
+        "  -u  use the URL-safe alphabet without padding\n"
+        "  -m  insert CRLF every %d characters (MIME)\n"
+        "  -w  insert CRLF every line_length characters\n"
+        "  -i  ignore non-encoding characters in decoding\n"
+        "  -q  do not report the throughput\n"
+        "  output_file is stdout if omitted or '-'\n",
+        name, B64_MIME_LINE_LENGTH);
+}
+
+// Parse the command line options
+static bool parse_options(Options* options, int argc, char* argv[]) {
+    options->decoding = false;
+    options->alphabet = &b64_std_alphabet;
+    options->use_padding = true;
+    options->line_length = 0;
+    options->validate = true;
+    options->quiet = false;
+    options->output_name = "-";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "dumw:iq")) != -1) {
+        switch (opt) {
+            case 'd':
+                options->decoding = true;
+                break;
+            case 'u':
+                options->alphabet = &b64_url_alphabet;
+                options->use_padding = false;
+                break;
+            case 'm':
+                options->line_length = B64_MIME_LINE_LENGTH;
+                break;
+            case 'w': {
+                char* end;
+                options->line_length = strtoul(optarg, &end, 10);
+                if (*end != '\0') {
+                    return false;
+                }
+                break;
+            }
+            case 'i':
+                options->validate = false;
+                break;
+            case 'q':
+                options->quiet = true;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    if (optind >= argc) {
+        return false;
+    }
+    options->input_name = argv[optind];
+    if ((optind + 1) < argc) {
+        options->output_name = argv[optind + 1];
+    }
+
+    return true;
+}
+
+// Open the input file to be mapped chunk by chunk
+static bool open_input(InputFile* file, const char* name) {
+    file->fd = open(name, O_RDONLY);
+    if (file->fd == -1) {
+        fprintf(stderr, "Error: failed to open %s: %s\n", name, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(file->fd, &st) == -1) {
+        fprintf(stderr, "Error: failed to get file size of %s: %s\n", name, strerror(errno));
+        close(file->fd);
+        return false;
+    }
+    file->size = (size_t)st.st_size;
+
+    // Pages are read ahead
+    posix_fadvise(file->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    return true;
+}
+
+static void close_input(InputFile* file) {
+    close(file->fd);
+}
+
+// Map a chunk of the input file, unmapped by munmap() after being processed
+// so that the resident memory does not grow with the file size
+static const void* map_chunk(const InputFile* file, const size_t offset, const size_t size, const char* name) {
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file->fd, (off_t)offset);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Error: failed to map %s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+
+    return data;
+}
+
+// Write all bytes to the file descriptor
+static bool write_all(const int fd, const void* buf, const size_t size) {
+    const uint8_t* bytes = buf;
+    size_t num_written = 0;
+    while (num_written < size) {
+        ssize_t n = write(fd, &bytes[num_written], size - num_written);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        num_written += (size_t)n;
+    }
+
+    return true;
+}
+
+// Encode the mapped input chunk by chunk, the output is written in large blocks
+static bool encode_file(const Options* options, const InputFile* input, const int output_fd, size_t* output_size) {
+    // Upper bound of the output of a chunk, including CRLF and the final block
+    const size_t num_chars = (CHUNK_SIZE + 2) / 3 * 4;
+    const size_t buf_size = num_chars + ((options->line_length == 0) ? 0 : ((num_chars / options->line_length + 1) * 2)) + B64_ENCODE_FINAL_SIZE;
+    char* buf = malloc(buf_size);
+    if (buf == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        return false;
+    }
+
+    B64EncodeState state;
+    b64_encode_init(&state, options->alphabet, options->use_padding, options->line_length);
+
+    size_t length;
+    *output_size = 0;
+    for (size_t i = 0; i < input->size; i += CHUNK_SIZE) {
+        const size_t size = ((input->size - i) < CHUNK_SIZE) ? (input->size - i) : CHUNK_SIZE;
+        const void* input_bytes = map_chunk(input, i, size, options->input_name);
+        if (input_bytes == NULL) {
+            free(buf);
+            return false;
+        }
+        const B64Result result = b64_encode_update(&state, &length, buf, buf_size, input_bytes, size);
+        munmap((void*)input_bytes, size);
+        if ((result != B64_SUCCESS) || !write_all(output_fd, buf, length)) {
+            fprintf(stderr, "Error: failed to encode %s\n", options->input_name);
+            free(buf);
+            return false;
+        }
+        *output_size += length;
+    }
+
+    if ((b64_encode_final(&state, &length, buf, buf_size) != B64_SUCCESS) ||
+        !write_all(output_fd, buf, length)) {
+        fprintf(stderr, "Error: failed to encode %s\n", options->input_name);
+        free(buf);
+        return false;
+    }
+    *output_size += length;
+
+    free(buf);
+
+    return true;
+}
+
+// Decode the mapped input chunk by chunk, the output is written in large blocks
+static bool decode_file(const Options* options, const InputFile* input, const int output_fd, size_t* output_size) {
+    // Upper bound of the output of a chunk, including the characters kept from the previous chunk
+    const size_t buf_size = (CHUNK_SIZE + 3) / 4 * 3;
+    uint8_t* buf = malloc(buf_size);
+    if (buf == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory\n");
+        return false;
+    }
+
+    B64DecodeState state;
+    b64_decode_init(&state, options->alphabet, options->validate);
+
+    size_t size;
+    *output_size = 0;
+    for (size_t i = 0; i < input->size; i += CHUNK_SIZE) {
+        const size_t length = ((input->size - i) < CHUNK_SIZE) ? (input->size - i) : CHUNK_SIZE;
+        const char* input_chars = map_chunk(input, i, length, options->input_name);
+        if (input_chars == NULL) {
+            free(buf);
+            return false;
+        }
+        B64Result result = b64_decode_update(&state, &size, buf, buf_size, input_chars, length);
+        munmap((void*)input_chars, length);
+        if (result != B64_SUCCESS) {
+            fprintf(stderr, "Error: failed to decode %s: %s at offset %zu\n", options->input_name, b64_result_string(result), state.num_read_chars);
+            free(buf);
+            return false;
+        }
+        if (!write_all(output_fd, buf, size)) {
+            fprintf(stderr, "Error: failed to decode %s\n", options->input_name);
+            free(buf);
+            return false;
+        }
+        *output_size += size;
+    }
+
+    // Empty input (or only linebreaks) is decoded to empty output
+    B64Result result = b64_decode_final(&state, &size, buf, buf_size);
+    if (result == B64_ERROR_EMPTY_INPUT) {
+        size = 0;
+        result = B64_SUCCESS;
+    }
+    if (result != B64_SUCCESS) {
+        fprintf(stderr, "Error: failed to decode %s: %s at offset %zu\n", options->input_name, b64_result_string(result), state.num_read_chars);
+        free(buf);
+        return false;
+    }
+    if (!write_all(output_fd, buf, size)) {
+        fprintf(stderr, "Error: failed to decode %s\n", options->input_name);
+        free(buf);
+        return false;
+    }
+    *output_size += size;
+
+    free(buf);
+
+    return true;
+}
+
+// Get the current time in seconds
+static double get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parse_options(&options, argc, argv)) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    InputFile input;
+    if (!open_input(&input, options.input_name)) {
+        exit(EXIT_FAILURE);
+    }
+
+    int output_fd = STDOUT_FILENO;
+    if (strcmp(options.output_name, "-") != 0) {
+        output_fd = open(options.output_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (output_fd == -1) {
+            fprintf(stderr, "Error: failed to open %s: %s\n", options.output_name, strerror(errno));
+            close_input(&input);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    double start = get_time();
+
+    size_t output_size;
+    bool succeeded = options.decoding ?
+        decode_file(&options, &input, output_fd, &output_size) :
+        encode_file(&options, &input, output_fd, &output_size);
+
+    double elapsed = get_time() - start;
+
+    if (output_fd != STDOUT_FILENO) {
+        close(output_fd);
+    }
+    close_input(&input);
+
+    if (!succeeded) {
+        exit(EXIT_FAILURE);
+    }
+
+    if (!options.quiet) {
+        fprintf(stderr, "%s %zu to %zu bytes in %.3f s (%.1f MB/s)\n",
+            options.decoding ? "Decoded" : "Encoded", input.size, output_size, elapsed,
+            (elapsed > 0.0) ? ((double)input.size / elapsed / 1e6) : 0.0);
+    }
+
+    return EXIT_SUCCESS;
+}